@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ACCESSSPLITTER_HPP
+#define ACCESSSPLITTER_HPP
+
+#include "Utils.hpp"
+
+#include <vector>
+
+// One request to the first level
+struct Access {
+    unsigned long address;
+    unsigned int bytes;
+    unsigned int threadId;
+    unsigned long pc;
+    bool isWrite;
+    // Request coming from a gather/scatter bundle
+    bool inBundle;
+    // Number of elements of the bundle, set in its first request only
+    unsigned int bundleElements;
+};
+
+/*
+ * Turns trace records into first level requests
+ *
+ * By default every record is split like sve-cachesim.py does: one request every
+ * first level line size bytes from its (unaligned) address. With coalescing,
+ * requests are split at line boundaries instead, and all the elements of a
+ * gather/scatter bundle are merged into one request per distinct line.
+ */
+class AccessSplitter {
+    unsigned int lineBytes;
+    unsigned int lineBits;
+    bool coalescing;
+    bool keepStores;
+
+    // Elements of a bundle not ended yet, possibly from a previous chunk
+    std::vector<memRecord> bundle;
+    std::vector<unsigned long> bundleLines;
+    // Bytes of the elements merged into every line, capped at the line size
+    std::vector<unsigned int> bundleBytes;
+
+    unsigned long bundles;
+    unsigned long elements;
+    unsigned long coalescedRequests;
+    unsigned long uncoalescedRequests;
+
+    void splitRecord(const memRecord &record, std::vector<Access> &accesses);
+    void flushBundle(std::vector<Access> &accesses);
+
+  public:
+    AccessSplitter(unsigned int lineBytes, bool coalescing, bool keepStores);
+
+    // Appends the requests of the records. Stores are dropped unless 'keepStores'
+    void split(const std::vector<memRecord> &records, std::vector<Access> &accesses);
+    // Appends the requests of an unfinished bundle at the end of the trace
+    void finish(std::vector<Access> &accesses);
+
+    // Counters start again from zero, e.g. at the end of the warmup
+    void resetStats() {
+        bundles = 0;
+        elements = 0;
+        coalescedRequests = 0;
+        uncoalescedRequests = 0;
+    }
+
+    unsigned long getBundles() const {
+        return bundles;
+    }
+
+    unsigned long getElements() const {
+        return elements;
+    }
+
+    unsigned long getCoalescedRequests() const {
+        return coalescedRequests;
+    }
+
+    // Requests the bundles would have needed with one request per element and line
+    unsigned long getUncoalescedRequests() const {
+        return uncoalescedRequests;
+    }
+};
+
+#endif
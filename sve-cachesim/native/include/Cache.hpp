@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CACHE_HPP
+#define CACHE_HPP
+
+#include "CacheModel.hpp"
+#include "ReplacementPolicy.hpp"
+
+#include <memory>
+#include <vector>
+#include <string>
+#include <istream>
+#include <ostream>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__ARM_FEATURE_SVE)
+#include <arm_sve.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// Tags compared at once by the widest of the vector units, the rows of tags are padded to it
+#define TAG_LANES 4
+
+/*
+ * One level of the cache hierarchy
+ *
+ * Tags of all the sets are kept in a single flat array (set * stride + way), the
+ * stride being the associativity rounded up to TAG_LANES so that a lookup compares
+ * whole vectors of tags (AVX2, SSE2, SVE or NEON, depending on the target). The
+ * padding ways are never valid. The per-way state (dirty, prefetched) uses the same
+ * layout. Empty ways are filled first, then the replacement policy of the level
+ * picks the victims. Sets are indexed with a mask when their number is a power of two.
+ */
+class Cache {
+    CacheConfig config;
+    unsigned int ways;
+    unsigned int stride;
+    unsigned int lineBits;
+    unsigned long numSets;
+    unsigned long setMask;
+    bool powerOfTwoSets;
+    // sve-cachesim.py indexes sets with the line address instead of the line number
+    bool compatIndexing;
+
+    // Line number of every way, INVALID_LINE if empty
+    std::vector<unsigned long> tags;
+    // Modified lines, only set when stores are simulated
+    std::vector<unsigned char> dirty;
+    // Lines brought in by the prefetcher and not used yet, and the cycle they arrive
+    std::vector<unsigned char> prefetched;
+    std::vector<unsigned long> readyCycle;
+    // Number of ways that have been filled in every set, and of those invalidated since
+    std::vector<unsigned int> filledWays;
+    std::vector<unsigned int> invalidWays;
+    std::unique_ptr<ReplacementPolicy> policy;
+
+  public:
+    static const unsigned long INVALID_LINE = ~0UL;
+
+    Cache(const CacheConfig &config, bool compatIndexing);
+
+    unsigned long getLine(unsigned long address) const {
+        return address >> lineBits;
+    }
+
+    unsigned long getAddress(unsigned long line) const {
+        return line << lineBits;
+    }
+
+    unsigned long getSet(unsigned long line) const {
+        unsigned long index = compatIndexing ? (line << lineBits) : line;
+        return powerOfTwoSets ? (index & setMask) : (index % numSets);
+    }
+
+    // Way holding the line, -1 if it is not in the set
+    int find(unsigned long line, unsigned long set) const {
+        const unsigned long *setTags = &tags[set * stride];
+#if defined(__AVX2__)
+        __m256i key = _mm256_set1_epi64x(line);
+        for ( unsigned int way = 0; way < ways; way += 4 ) {
+            __m256i equal = _mm256_cmpeq_epi64(_mm256_loadu_si256((const __m256i *) (setTags + way)), key);
+            int mask = _mm256_movemask_pd(_mm256_castsi256_pd(equal));
+            if ( mask != 0 ) {
+                return way + __builtin_ctz(mask);
+            }
+        }
+        return -1;
+#elif defined(__SSE2__)
+        // No 64-bit compare in SSE2: both 32-bit halves must be equal
+        __m128i key = _mm_set1_epi64x(line);
+        for ( unsigned int way = 0; way < ways; way += 2 ) {
+            __m128i equal = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i *) (setTags + way)), key);
+            equal = _mm_and_si128(equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1)));
+            int mask = _mm_movemask_pd(_mm_castsi128_pd(equal));
+            if ( mask != 0 ) {
+                return way + __builtin_ctz(mask);
+            }
+        }
+        return -1;
+#elif defined(__ARM_FEATURE_SVE)
+        for ( unsigned int way = 0; way < ways; way += svcntd() ) {
+            svbool_t active = svwhilelt_b64_u32(way, ways);
+            svbool_t equal = svcmpeq_n_u64(active, svld1_u64(active, (const uint64_t *) (setTags + way)), line);
+            if ( svptest_any(active, equal) ) {
+                return way + svcntp_b64(active, svbrkb_b_z(active, equal));
+            }
+        }
+        return -1;
+#elif defined(__ARM_NEON)
+        uint64x2_t key = vdupq_n_u64(line);
+        for ( unsigned int way = 0; way < ways; way += 2 ) {
+            uint64x2_t equal = vceqq_u64(vld1q_u64((const uint64_t *) (setTags + way)), key);
+            // One 32-bit lane per way
+            uint64_t mask = vget_lane_u64(vreinterpret_u64_u32(vmovn_u64(equal)), 0);
+            if ( mask != 0 ) {
+                return way + (__builtin_ctzll(mask) >> 5);
+            }
+        }
+        return -1;
+#else
+        for ( unsigned int way = 0; way < ways; way++ ) {
+            if ( setTags[way] == line ) {
+                return way;
+            }
+        }
+        return -1;
+#endif
+    }
+
+    // Tells the replacement policy about a hit
+    void touch(unsigned long set, int way) {
+        policy->touch(set, way);
+    }
+
+    // Brings the line in, replacing the policy's victim. Returns the way, the replaced line
+    // (INVALID_LINE if the way was empty) and whether it was dirty
+    unsigned int fill(unsigned long line, unsigned long set, bool isDirty, unsigned long &victimLine, bool &victimDirty) {
+        unsigned int victim;
+        bool invalidWay = false;
+        if ( filledWays[set] < ways ) {
+            victim = filledWays[set]++;
+        } else if ( invalidWays[set] > 0 ) {
+            victim = 0;
+            while ( tags[set * stride + victim] != INVALID_LINE ) {
+                victim++;
+            }
+            invalidWays[set]--;
+            invalidWay = true;
+        } else {
+            victim = policy->victim(set);
+        }
+        unsigned long index = set * stride + victim;
+        victimLine = tags[index];
+        victimDirty = dirty[index];
+        tags[index] = line;
+        dirty[index] = isDirty;
+        prefetched[index] = 0;
+        if ( invalidWay ) {
+            policy->refill(set, victim);
+        } else {
+            policy->insert(set, victim);
+        }
+        return victim;
+    }
+
+    void setDirty(unsigned long set, int way) {
+        dirty[set * stride + way] = 1;
+    }
+
+    bool isDirty(unsigned long set, int way) const {
+        return dirty[set * stride + way];
+    }
+
+    void clearDirty(unsigned long set, int way) {
+        dirty[set * stride + way] = 0;
+    }
+
+    // Removes a line, e.g. when another core writes it. The way is reused before any victim
+    void invalidate(unsigned long set, int way) {
+        unsigned long index = set * stride + way;
+        tags[index] = INVALID_LINE;
+        dirty[index] = 0;
+        prefetched[index] = 0;
+        invalidWays[set]++;
+    }
+
+    void setPrefetched(unsigned long set, int way, unsigned long ready) {
+        prefetched[set * stride + way] = 1;
+        readyCycle[set * stride + way] = ready;
+    }
+
+    // Clears the prefetched mark of a line on its first demand hit. Returns whether it was set
+    bool usePrefetched(unsigned long set, int way, unsigned long &ready) {
+        unsigned long index = set * stride + way;
+        if ( !prefetched[index] ) {
+            return false;
+        }
+        prefetched[index] = 0;
+        ready = readyCycle[index];
+        return true;
+    }
+
+    // Tags, dirty bits and replacement state, for snapshots. Loading checks the geometry,
+    // and a snapshot of another replacement policy only restores the lines
+    void save(std::ostream &os) const;
+    bool load(std::istream &is, std::string &error);
+
+    const CacheConfig &getConfig() const {
+        return config;
+    }
+
+    unsigned long getNumSets() const {
+        return numSets;
+    }
+};
+
+#endif
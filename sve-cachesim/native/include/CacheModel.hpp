@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CACHEMODEL_HPP
+#define CACHEMODEL_HPP
+
+#include "Json.hpp"
+
+#include <string>
+#include <vector>
+
+// Parameters of one cache level, as found in the model JSON files
+struct CacheConfig {
+    unsigned int level;
+    unsigned long cacheSize;  // Total size in bytes
+    unsigned int lineSize;    // Words per line
+    unsigned int setSize;     // Associativity
+    unsigned int wordSize;    // Bytes per word
+    unsigned int latency;     // Access latency in cycles
+    unsigned int memLatency;  // Main memory latency in cycles
+    bool writeBack;           // Write-back (true) or write-through (false)
+    bool writeAllocate;       // Stores that miss bring the line in
+    std::string replacement;  // Replacement policy name
+    unsigned int mshrs;       // Misses in flight, for the timing model
+    bool inclusive;           // Lines evicted here are removed from the levels above
+    bool exclusive;           // Only holds the victims of the level above
+
+    unsigned int lineBytes() const {
+        return lineSize * wordSize;
+    }
+};
+
+// Parameters of one TLB level, objects with "tlblevel" in the model JSON files
+struct TlbConfig {
+    unsigned int level;
+    unsigned int entries;
+    unsigned int setSize;      // Associativity
+    unsigned long pageSize;    // Bytes per page
+    unsigned int latency;      // Cycles of a hit in this level
+    unsigned int missPenalty;  // Extra cycles of a miss, the page walk for the last level
+};
+
+/*
+ * Cache model, loaded from the same JSON files used by sve-cachesim.py
+ *
+ * The file is an array of objects: one with "nlevels", one per cache level
+ * (with "level") and, optionally, one per TLB level (with "tlblevel") and one with
+ * the prefetcher "fetch_level". sve-cachesim.py expects the cache levels right after
+ * the "nlevels" object and the "fetch_level" last, so TLB levels go in between.
+ */
+class CacheModel {
+    std::string name;
+    std::vector<CacheConfig> levels;
+    std::vector<TlbConfig> tlbLevels;
+    int fetchLevel;
+    unsigned int fetchLevelLatency;
+    unsigned int prefetchDegree;
+    unsigned int prefetchDistance;
+    bool storesEnabled;
+    bool inclusionEnabled;
+    unsigned int window;
+
+  public:
+    CacheModel();
+
+    // Returns false and fills 'error' if the file cannot be used
+    bool load(const std::string &fileName, std::string &error);
+    // Divides the size of every level by 'ratio', keeping lines and associativity, for set
+    // sampling. Returns false and fills 'error' if a level would not hold a single set
+    bool sampleSets(unsigned int ratio, std::string &error);
+
+    // File name, without directories nor the .json extension
+    std::string getName() const;
+    unsigned int getNumLevels() const;
+    const CacheConfig &getLevel(unsigned int level) const;
+    // TLB levels, none if the model does not simulate translations
+    unsigned int getNumTlbLevels() const;
+    const TlbConfig &getTlbLevel(unsigned int level) const;
+    // Level (0-based) where prefetched lines are loaded, -1 if the model has none
+    int getFetchLevel() const;
+    unsigned int getFetchLevelLatency() const;
+    // "prefetch_degree" and "prefetch_distance" of the fetch level object, 1 by default
+    unsigned int getPrefetchDegree() const;
+    unsigned int getPrefetchDistance() const;
+    // Stores are only simulated when a level sets "writepolicy" or "writealloc",
+    // so models written for sve-cachesim.py keep giving the same results
+    bool simulatesStores() const;
+    // A level sets "inclusion", so the report shows replacements
+    bool hasInclusionPolicies() const;
+    // Accesses in flight of the timing model, "window" of the nlevels object
+    unsigned int getWindow() const;
+};
+
+#endif
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef HIERARCHY_HPP
+#define HIERARCHY_HPP
+
+#include "Cache.hpp"
+#include "CacheModel.hpp"
+
+#include <vector>
+#include <string>
+
+// Per-level counters, with the same meaning as in sve-cachesim.py
+struct LevelStats {
+    unsigned long hits;
+    unsigned long accesses;
+    // Demand misses (reported as "Evicts")
+    unsigned long evicts;
+    // Only counted when stores are simulated
+    unsigned long writeAccesses;
+    unsigned long writeHits;
+    // Lines written to the next level (dirty victims, or stores on write-through levels)
+    unsigned long writebacks;
+    // Prefetches that missed in this level, at or below the fetch level
+    unsigned long prefetchEvicts;
+    // Valid lines replaced, lines removed from the levels above when an inclusive level
+    // replaces them, and victims of the level above put into an exclusive level
+    unsigned long replacements;
+    unsigned long backInvalidations;
+    unsigned long victimFills;
+};
+
+// Prefetcher effectiveness, measured at the fetch level
+struct PrefetchStats {
+    unsigned long requests;
+    // Prefetches that brought a line into the fetch level
+    unsigned long fills;
+    // Prefetched lines hit by a demand access, and those that had not arrived yet
+    unsigned long useful;
+    unsigned long late;
+};
+
+// Request flowing from one level to the next in a batch simulation
+enum requestType { READ_REQUEST, WRITE_REQUEST, WRITEBACK_REQUEST };
+
+struct Request {
+    unsigned long address;
+    unsigned int bytes;
+    unsigned int type;
+    // Demand access the request belongs to, in the batch (unused for writebacks)
+    unsigned int demand;
+};
+
+// Requests a level sends to the next one for every request it gets
+struct RequestSlot {
+    Request requests[2];
+    unsigned int count;
+};
+
+// Counters of one shard of a batch simulation
+struct ShardState {
+    std::vector<LevelStats> stats;
+};
+
+/*
+ * Single-core multi-level cache hierarchy
+ *
+ * A request goes down the levels until it hits. Every level that misses gets the
+ * line (non-inclusive non-exclusive, as in sve-cachesim.py) unless it is exclusive:
+ * those only get the victims of the level above, and give their lines up to it on
+ * a hit. Lines replaced in an inclusive level are removed from the levels above.
+ * Prefetches start at the fetch level of the model.
+ */
+class Hierarchy {
+    std::vector<Cache> levels;
+    std::vector<LevelStats> stats;
+    unsigned long memReadBytes;
+    unsigned long memWriteBytes;
+
+    // Some level is inclusive or exclusive, so loads take the slower general path
+    bool inclusionPolicies;
+
+    int fetchLevel;
+    PrefetchStats prefetchStats;
+    // Cycle of the current demand access, to know whether prefetches arrived in time
+    unsigned long cycle;
+
+    void writeLine(unsigned int level, unsigned long address, unsigned int bytes);
+    unsigned int fillLine(unsigned int level, unsigned long line, unsigned long set, bool isDirty);
+    void evictLine(unsigned int level, unsigned long address, bool isDirty);
+    bool backInvalidate(unsigned int level, unsigned long address);
+    bool moveUp(unsigned int level, unsigned long address, unsigned long set, int way,
+        unsigned int &upperLevel, unsigned long &upperSet, int &upperWay);
+    void fillVictim(unsigned int level, unsigned long address, bool isDirty);
+
+    // Victims of the levels filled by a demand access, put into the exclusive levels below
+    // once the demand has looked them up, so that a victim cannot replace the line requested
+    struct PendingVictim {
+        unsigned int level;
+        unsigned long address;
+        bool isDirty;
+    };
+    bool deferVictims;
+    std::vector<PendingVictim> pendingVictims;
+    void fillPendingVictims();
+
+    // Batch simulation: every level handles the whole batch, split by sets between threads
+    std::vector<ShardState> shards;
+    static void *simulateShard(void *shardArgs);
+    void processRequest(unsigned int level, const Request &request, ShardState &shard,
+        RequestSlot &slot, std::vector<unsigned int> &hitLevels);
+
+    void checkPrefetched(Cache &cache, unsigned long set, int way) {
+        unsigned long ready;
+        if ( cache.usePrefetched(set, way, ready) ) {
+            prefetchStats.useful++;
+            if ( cycle < ready ) {
+                prefetchStats.late++;
+            }
+        }
+    }
+
+  public:
+    Hierarchy(const CacheModel &model, bool compatIndexing);
+
+    unsigned int getNumLevels() const {
+        return levels.size();
+    }
+
+    // Demand access. Returns the level that hit, or getNumLevels() if it went to memory
+    unsigned int access(unsigned long address) {
+        if ( inclusionPolicies ) {
+            return access(address, false, 0);
+        }
+        unsigned int numLevels = levels.size();
+        for ( unsigned int level = 0; level < numLevels; level++ ) {
+            Cache &cache = levels[level];
+            unsigned long line = cache.getLine(address);
+            unsigned long set = cache.getSet(line);
+            int way = cache.find(line, set);
+            stats[level].accesses++;
+            if ( way >= 0 ) {
+                cache.touch(set, way);
+                stats[level].hits++;
+                if ( (int) level == fetchLevel ) {
+                    checkPrefetched(cache, set, way);
+                }
+                return level;
+            }
+            stats[level].evicts++;
+            unsigned long victimLine;
+            bool victimDirty;
+            cache.fill(line, set, false, victimLine, victimDirty);
+            if ( victimLine != Cache::INVALID_LINE ) {
+                stats[level].replacements++;
+            }
+        }
+        return numLevels;
+    }
+
+    // Demand access with write-back/write-allocate modelling, used when the model simulates stores.
+    // Returns the level that hit, or getNumLevels() if it went to memory
+    unsigned int access(unsigned long address, bool isWrite, unsigned int bytes);
+
+    /*
+     * Simulates a batch of demand requests, level by level, with every level split by
+     * sets between 'numThreads' threads. Results are the same as with access(), and
+     * hitLevels gets the level that served every demand request.
+     * Prefetching is not supported
+     */
+    void accessBatch(const std::vector<Request> &demands, std::vector<unsigned int> &hitLevels, unsigned int numThreads);
+
+    // Brings the line into the fetch level (and the levels below it that miss)
+    void prefetch(unsigned long address);
+
+    void setCycle(unsigned long cycle) {
+        this->cycle = cycle;
+    }
+
+    // Latency of a request served by 'level' (getNumLevels() for memory)
+    unsigned int getLatency(unsigned int level) const {
+        if ( level == levels.size() ) {
+            return levels.back().getConfig().memLatency;
+        }
+        return levels[level].getConfig().latency;
+    }
+
+    // Snapshot of the contents of all the levels, to skip the warmup of later runs
+    bool saveSnapshot(const std::string &fileName, std::string &error) const;
+    bool loadSnapshot(const std::string &fileName, std::string &error);
+    // Counters start again from zero, e.g. at the end of the warmup
+    void resetStats();
+
+    // Inclusive or exclusive levels need the sequential simulation
+    bool hasInclusionPolicies() const {
+        return inclusionPolicies;
+    }
+
+    const Cache &getLevel(unsigned int level) const {
+        return levels[level];
+    }
+
+    const LevelStats &getStats(unsigned int level) const {
+        return stats[level];
+    }
+
+    unsigned long getMemReadBytes() const {
+        return memReadBytes;
+    }
+
+    unsigned long getMemWriteBytes() const {
+        return memWriteBytes;
+    }
+
+    const PrefetchStats &getPrefetchStats() const {
+        return prefetchStats;
+    }
+};
+
+#endif
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JSON_HPP
+#define JSON_HPP
+
+#include <string>
+#include <vector>
+#include <map>
+
+/*
+ * Minimal JSON reader, just enough for the cache model files.
+ * Numbers are kept as doubles, objects as ordered maps.
+ */
+class JsonValue {
+  public:
+    enum jsonType { JSON_NULL, JSON_BOOL, JSON_NUMBER, JSON_STRING, JSON_ARRAY, JSON_OBJECT };
+
+    JsonValue();
+
+    // Returns false and fills 'error' if the text is not valid JSON
+    bool parse(const std::string &text, std::string &error);
+
+    jsonType getType() const;
+    bool isObject() const;
+    bool isArray() const;
+    bool isNumber() const;
+    bool isString() const;
+    bool isBool() const;
+
+    double getNumber() const;
+    const std::string &getString() const;
+    bool getBool() const;
+
+    // Arrays
+    unsigned int size() const;
+    const JsonValue &operator[](unsigned int index) const;
+
+    // Objects
+    bool has(const std::string &key) const;
+    const JsonValue &operator[](const std::string &key) const;
+    const std::map<std::string, JsonValue> &getMembers() const;
+
+  private:
+    jsonType type;
+    bool boolValue;
+    double numberValue;
+    std::string stringValue;
+    std::vector<JsonValue> arrayValue;
+    std::map<std::string, JsonValue> objectValue;
+
+    bool parseValue(const std::string &text, size_t &pos, std::string &error);
+};
+
+#endif
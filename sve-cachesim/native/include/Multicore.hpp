@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MULTICORE_HPP
+#define MULTICORE_HPP
+
+#include "Cache.hpp"
+#include "CacheModel.hpp"
+#include "Hierarchy.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+struct CoherenceStats {
+    // Writes that hit a shared copy and had to invalidate the others
+    unsigned long upgrades;
+    // Private copies removed because another core wrote the line
+    unsigned long invalidations;
+    // Private misses on lines that had been invalidated by another core
+    unsigned long coherenceMisses;
+    // Modified copies written back to the last level for another core
+    unsigned long coherenceWritebacks;
+};
+
+/*
+ * Multicore hierarchy: every thread of the trace (TID) gets its own private copy of
+ * all the levels of the model but the last one, which is shared.
+ *
+ * A directory next to the shared level keeps the sharers (a bit per core) and the
+ * owner of every coherence granule, the largest private line size. Writes invalidate
+ * the copies of the other cores, and reads downgrade a modified copy to shared (MSI).
+ * With MESI a line read by a single core is exclusive, and writing it needs no upgrade.
+ * Private lines are evicted silently, so sharers are checked before being used.
+ */
+class Multicore {
+    struct Core {
+        unsigned int tid;
+        std::vector<Cache> levels;
+        // Granules this core lost to an invalidation, for the coherence misses
+        std::unordered_set<unsigned long> lostGranules;
+    };
+
+    struct DirectoryEntry {
+        uint64_t sharers;
+        // Core with an exclusive or modified copy, -1 if none
+        int owner;
+    };
+
+    std::vector<CacheConfig> privateConfigs;
+    bool compatIndexing;
+    bool mesi;
+    unsigned int numLevels;
+    unsigned int granuleBits;
+
+    std::vector<std::unique_ptr<Core> > cores;
+    std::unordered_map<unsigned int, unsigned int> tidCores;
+    Cache sharedLevel;
+    std::unordered_map<unsigned long, DirectoryEntry> directory;
+
+    std::vector<LevelStats> stats;
+    CoherenceStats coherenceStats;
+    unsigned long memReadBytes;
+    unsigned long memWriteBytes;
+
+    unsigned int getCore(unsigned int tid);
+    Cache &getCache(unsigned int core, unsigned int level) {
+        return (level + 1 == numLevels) ? sharedLevel : cores[core]->levels[level];
+    }
+
+    void writeLine(unsigned int core, unsigned int level, unsigned long address, unsigned int bytes);
+    void fillLine(unsigned int core, unsigned int level, unsigned long line, unsigned long set, bool isDirty);
+
+    bool hasGranule(unsigned int core, unsigned long granule);
+    bool removeGranule(unsigned int core, unsigned long granule, bool invalidate);
+    void invalidateSharers(unsigned int core, unsigned long granule, DirectoryEntry &entry);
+    void readShared(unsigned int core, unsigned long granule);
+    void takeOwnership(unsigned int core, unsigned long granule, bool isUpgrade);
+
+  public:
+    static const unsigned int MAX_CORES = 64;
+
+    Multicore(const CacheModel &model, bool compatIndexing, bool mesi);
+
+    // Demand access of a thread. Returns the level that hit, or getNumLevels() if it went to memory
+    unsigned int access(unsigned int tid, unsigned long address, bool isWrite, unsigned int bytes);
+
+    unsigned int getNumLevels() const {
+        return numLevels;
+    }
+
+    unsigned int getNumCores() const {
+        return cores.size();
+    }
+
+    unsigned int getLatency(unsigned int level) const {
+        if ( level == numLevels ) {
+            return sharedLevel.getConfig().memLatency;
+        }
+        return (level + 1 == numLevels) ? sharedLevel.getConfig().latency : privateConfigs[level].latency;
+    }
+
+    // Counters start again from zero, e.g. at the end of the warmup
+    void resetStats();
+
+    // Private levels add up the counters of all the cores
+    const LevelStats &getStats(unsigned int level) const {
+        return stats[level];
+    }
+
+    const CoherenceStats &getCoherenceStats() const {
+        return coherenceStats;
+    }
+
+    unsigned long getMemReadBytes() const {
+        return memReadBytes;
+    }
+
+    unsigned long getMemWriteBytes() const {
+        return memWriteBytes;
+    }
+};
+
+#endif
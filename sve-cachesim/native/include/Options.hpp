@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+#ifndef OPTIONS_HPP
+#define OPTIONS_HPP
+
+#include <unistd.h>
+#include <iostream>
+
+class Options {
+    std::string outputFile;
+    std::string traceFile;
+    std::string modelFile;
+    std::string prefetcher;
+    std::string coherenceProtocol;
+    unsigned int sweepLevel;
+    unsigned long minSweepSize;
+    unsigned long maxSweepSize;
+    unsigned long minSweepWays;
+    unsigned long maxSweepWays;
+    bool compatIndexing;
+    bool coalescing;
+    bool timing;
+    unsigned int sampleRatio;
+    bool hashedSampling;
+    unsigned long warmupRecords;
+    unsigned long warmupSeqNumber;
+    std::string saveSnapshotFile;
+    std::string loadSnapshotFile;
+    unsigned int topPcs;
+    unsigned int bufferedChunks;
+    unsigned int concurrentThreads;
+#ifdef ENABLE_GZIP
+    bool zipped;
+#endif
+
+  public:
+    Options();
+    void readOptions(int argc, char *argv[]);
+
+    std::string getTraceFile();
+    std::string getModelFile();
+    std::string getOutFile();
+    std::string getPrefetcher();
+    // msi or mesi with -m, empty for a single core simulation
+    std::string getCoherenceProtocol();
+    // Level (1-based) to sweep with -W, 0 for a normal simulation
+    unsigned int getSweepLevel();
+    unsigned long getMinSweepSize();
+    unsigned long getMaxSweepSize();
+    unsigned int getMinSweepWays();
+    unsigned int getMaxSweepWays();
+    bool isCompatIndexing();
+    // Split accesses at line boundaries and merge the bundle elements that share a line (-g)
+    bool isCoalescing();
+    // Overlap misses with the MSHR and window timing model (-T)
+    bool isTiming();
+    // Simulate one in getSampleRatio() sets with -s, 1 for a full simulation
+    unsigned int getSampleRatio();
+    bool isHashedSampling();
+    // Records simulated without counters with -w <records>, or those before a sequence number
+    // with -w @<seqNumber>. 0 if there is no warmup
+    unsigned long getWarmupRecords();
+    unsigned long getWarmupSeqNumber();
+    // Snapshot of the caches written after the warmup (-x), or read before the simulation (-i)
+    std::string getSaveSnapshotFile();
+    std::string getLoadSnapshotFile();
+    // Number of PCs of the per-PC table with -P, 0 for none
+    unsigned int getTopPcs();
+    unsigned int getBufferedChunks();
+    unsigned int getConcurrentThreads();
+#ifdef ENABLE_GZIP
+    bool isZipped();
+#endif
+};
+
+#endif
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PCPROFILE_HPP
+#define PCPROFILE_HPP
+
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+/*
+ * Per-PC counters of the demand accesses, to find the instructions that
+ * spend most of the cycles in the memory hierarchy
+ */
+class PcProfile {
+    struct PcStats {
+        unsigned long accesses;
+        unsigned long misses;
+        unsigned long cycles;
+        // Hits of every level
+        std::vector<unsigned long> hits;
+    };
+
+    unsigned int numLevels;
+    std::unordered_map<unsigned long, PcStats> pcs;
+
+  public:
+    PcProfile(unsigned int numLevels);
+
+    // Access served by 'level' (numLevels for memory)
+    void record(unsigned long pc, unsigned int level, unsigned long cycles) {
+        PcStats &stats = pcs[pc];
+        if ( stats.hits.empty() ) {
+            stats.hits = std::vector<unsigned long>(numLevels, 0);
+        }
+        stats.accesses++;
+        stats.cycles += cycles;
+        if ( level < numLevels ) {
+            stats.hits[level]++;
+        } else {
+            stats.misses++;
+        }
+    }
+
+    void clear() {
+        pcs.clear();
+    }
+
+    // Table of the 'top' PCs with most cycles. Counts are multiplied by 'scale' (set sampling)
+    void printReport(std::ostream &os, unsigned int top, double scale) const;
+};
+
+#endif
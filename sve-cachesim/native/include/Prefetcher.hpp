@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PREFETCHER_HPP
+#define PREFETCHER_HPP
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+/*
+ * Hardware prefetcher model
+ *
+ * The simulator shows every demand access to the prefetcher, which returns the
+ * addresses to be prefetched into the fetch level of the model. The degree is the
+ * number of prefetches issued at once and the distance how far ahead they start.
+ */
+class Prefetcher {
+  protected:
+    unsigned int degree;
+    unsigned int distance;
+    unsigned int lineBits;
+
+  public:
+    Prefetcher(unsigned int degree, unsigned int distance, unsigned int lineBytes);
+    virtual ~Prefetcher() {}
+
+    // 'miss' is set if the demand access missed in the first level
+    virtual void observe(unsigned long address, unsigned long pc, bool miss, std::vector<unsigned long> &prefetches) = 0;
+
+    static bool isValid(const std::string &name);
+    static std::string getNames();
+    static Prefetcher *create(const std::string &name, unsigned int degree, unsigned int distance, unsigned int lineBytes);
+};
+
+/*
+ * Port of prefetch_commonStride.py: looks at the last 100 addresses and prefetches
+ * the last one plus the most common non-zero stride. Like the plugin, it actually
+ * adds the number of times that stride was seen, so it gives the same results as
+ * sve-cachesim.py. The strides are counted incrementally instead of every access
+ */
+class CommonStridePrefetcher : public Prefetcher {
+    static const unsigned int HISTORY = 100;
+
+    // Last addresses, as a ring
+    std::vector<unsigned long> history;
+    unsigned int historyStart;
+    unsigned int historySize;
+    // Occurrences of every stride in the history, and number of strides with every count
+    std::unordered_map<long, unsigned int> strideCounts;
+    std::vector<unsigned int> countFrequency;
+    unsigned int maxCount;
+
+    void addStride(long stride);
+    void removeStride(long stride);
+
+  public:
+    CommonStridePrefetcher(unsigned int degree, unsigned int distance, unsigned int lineBytes);
+    void observe(unsigned long address, unsigned long pc, bool miss, std::vector<unsigned long> &prefetches);
+};
+
+// Per-PC stride prefetcher, with a direct-mapped reference prediction table
+class StridePrefetcher : public Prefetcher {
+    static const unsigned int TABLE_ENTRIES = 256;
+    static const unsigned int MAX_CONFIDENCE = 3;
+    static const unsigned int MIN_CONFIDENCE = 2;
+
+    struct Entry {
+        unsigned long pc;
+        unsigned long lastAddress;
+        long stride;
+        unsigned int confidence;
+    };
+    std::vector<Entry> table;
+
+  public:
+    StridePrefetcher(unsigned int degree, unsigned int distance, unsigned int lineBytes);
+    void observe(unsigned long address, unsigned long pc, bool miss, std::vector<unsigned long> &prefetches);
+};
+
+// Prefetches the next lines after every first level miss
+class NextLinePrefetcher : public Prefetcher {
+  public:
+    NextLinePrefetcher(unsigned int degree, unsigned int distance, unsigned int lineBytes);
+    void observe(unsigned long address, unsigned long pc, bool miss, std::vector<unsigned long> &prefetches);
+};
+
+/*
+ * Stream prefetcher: first level misses close to a tracked stream confirm its
+ * direction, and then the stream prefetches ahead of the last miss
+ */
+class StreamPrefetcher : public Prefetcher {
+    static const unsigned int STREAMS = 16;
+    // Misses within this many lines of a stream belong to it
+    static const long WINDOW = 16;
+
+    struct Stream {
+        long lastLine;
+        int direction;   // 0 until confirmed
+        unsigned long lastUse;
+        bool valid;
+    };
+    std::vector<Stream> streams;
+    unsigned long misses;
+
+  public:
+    StreamPrefetcher(unsigned int degree, unsigned int distance, unsigned int lineBytes);
+    void observe(unsigned long address, unsigned long pc, bool miss, std::vector<unsigned long> &prefetches);
+};
+
+#endif
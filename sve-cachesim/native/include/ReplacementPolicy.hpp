@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REPLACEMENTPOLICY_HPP
+#define REPLACEMENTPOLICY_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+
+/*
+ * Replacement policy of a cache level
+ *
+ * The cache tells the policy about every hit and fill, and asks it for a victim once
+ * the set is full. All the policies do a constant amount of work per call (PLRU walks
+ * log2(ways) tree levels), regardless of the associativity.
+ */
+class ReplacementPolicy {
+  protected:
+    unsigned long numSets;
+    unsigned int ways;
+
+  public:
+    ReplacementPolicy(unsigned long numSets, unsigned int ways) : numSets(numSets), ways(ways) {}
+    virtual ~ReplacementPolicy() {}
+
+    // A line in 'way' was accessed and hit
+    virtual void touch(unsigned long set, unsigned int way) = 0;
+    // A new line was brought into 'way'
+    virtual void insert(unsigned long set, unsigned int way) = 0;
+    // A new line was brought into a way left empty by an invalidation, not chosen by the policy
+    virtual void refill(unsigned long set, unsigned int way) {
+        insert(set, way);
+    }
+    // Way to be replaced in a full set
+    virtual unsigned int victim(unsigned long set) = 0;
+
+    // State of all the sets, for snapshots. Only loaded into a policy of the same name and geometry
+    virtual void save(std::ostream &os) const = 0;
+    virtual bool load(std::istream &is) = 0;
+
+    // Names accepted in the "replacement" key of the model, fifo is the default
+    static bool isValid(const std::string &name);
+    // Largest associativity supported by the policy
+    static unsigned int getMaxWays(const std::string &name);
+    static ReplacementPolicy *create(const std::string &name, unsigned long numSets, unsigned int ways);
+};
+
+// Replaces lines in the order they were brought in, like sve-cachesim.py
+class FifoPolicy : public ReplacementPolicy {
+    std::vector<unsigned int> nextVictim;
+
+  public:
+    FifoPolicy(unsigned long numSets, unsigned int ways);
+    void touch(unsigned long set, unsigned int way) {}
+    void insert(unsigned long set, unsigned int way) {
+        nextVictim[set] = (way + 1 == ways) ? 0 : way + 1;
+    }
+    // Keeps the order of the other lines, the pointer only moves past the ways it chose
+    void refill(unsigned long set, unsigned int way) {}
+    unsigned int victim(unsigned long set) {
+        return nextVictim[set];
+    }
+    void save(std::ostream &os) const;
+    bool load(std::istream &is);
+};
+
+// True LRU: every set keeps its ways in a doubly linked list, most recently used first
+class LruPolicy : public ReplacementPolicy {
+    std::vector<uint16_t> prev;
+    std::vector<uint16_t> next;
+    std::vector<uint16_t> head;
+    std::vector<uint16_t> tail;
+
+    void moveToFront(unsigned long set, unsigned int way);
+
+  public:
+    LruPolicy(unsigned long numSets, unsigned int ways);
+    void touch(unsigned long set, unsigned int way) {
+        moveToFront(set, way);
+    }
+    void insert(unsigned long set, unsigned int way) {
+        moveToFront(set, way);
+    }
+    unsigned int victim(unsigned long set) {
+        return tail[set];
+    }
+    void save(std::ostream &os) const;
+    bool load(std::istream &is);
+};
+
+// Tree pseudo-LRU. Non power of two associativities are padded, and the padding
+// leaves are never chosen
+class PlruPolicy : public ReplacementPolicy {
+    // One bit per tree node (heap order, root is node 1), set when the victim is on the right
+    std::vector<uint64_t> trees;
+    unsigned int leaves;
+    unsigned int depth;
+
+  public:
+    PlruPolicy(unsigned long numSets, unsigned int ways);
+    void touch(unsigned long set, unsigned int way);
+    void insert(unsigned long set, unsigned int way) {
+        touch(set, way);
+    }
+    unsigned int victim(unsigned long set);
+    void save(std::ostream &os) const;
+    bool load(std::istream &is);
+};
+
+// Static and bimodal re-reference interval prediction with 2-bit RRPVs, stored as two
+// bit-planes per set. BRRIP inserts at the distant RRPV, except for 1 in 32 fills
+class RripPolicy : public ReplacementPolicy {
+    static const unsigned int BIMODAL_THROTTLE = 32;
+
+    std::vector<uint64_t> lowBits;
+    std::vector<uint64_t> highBits;
+    std::vector<uint32_t> randomState;
+    uint64_t waysMask;
+    bool bimodal;
+
+  public:
+    RripPolicy(unsigned long numSets, unsigned int ways, bool bimodal);
+    void touch(unsigned long set, unsigned int way) {
+        lowBits[set] &= ~(1UL << way);
+        highBits[set] &= ~(1UL << way);
+    }
+    void insert(unsigned long set, unsigned int way);
+    unsigned int victim(unsigned long set);
+    void save(std::ostream &os) const;
+    bool load(std::istream &is);
+};
+
+// Random replacement. Every set has its own generator, so results do not depend on the
+// order in which different sets are simulated
+class RandomPolicy : public ReplacementPolicy {
+    std::vector<uint32_t> randomState;
+
+  public:
+    RandomPolicy(unsigned long numSets, unsigned int ways);
+    void touch(unsigned long set, unsigned int way) {}
+    void insert(unsigned long set, unsigned int way) {}
+    unsigned int victim(unsigned long set);
+    void save(std::ostream &os) const;
+    bool load(std::istream &is);
+};
+
+#endif
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SETSAMPLER_HPP
+#define SETSAMPLER_HPP
+
+#include "CacheModel.hpp"
+
+#include <vector>
+
+#define SAMPLE_CLUSTERS 64
+#define SAMPLE_GROUP 64
+
+/*
+ * Set sampling: only one in 'ratio' lines (at the largest line size of the model)
+ * is simulated, in a hierarchy with 'ratio' times fewer sets per level
+ *
+ * Line numbers are split in groups of SAMPLE_GROUP * 'ratio' consecutive lines, and
+ * the same 1/'ratio' of the positions in the group are kept everywhere: multiples
+ * of 'ratio' with stride sampling, those with the lowest hashes with hashed sampling.
+ * Kept lines are renumbered consecutively, so with stride sampling and power-of-two
+ * sets this is the same as simulating one in 'ratio' sets of every level.
+ *
+ * The results are scaled by all the accesses over the sampled ones. The 95%
+ * confidence intervals come from the variation between clusters of sampled lines.
+ */
+class SetSampler {
+    unsigned int groupBits;
+    unsigned long groupMask;
+    unsigned int keptPerGroup;
+    unsigned int lineBits;
+    // New position of every position of the group, -1 if it is not sampled
+    std::vector<int> positions;
+
+    unsigned long accesses;
+    unsigned long sampledAccesses;
+    // Sampled accesses, misses and cycles of every cluster
+    std::vector<unsigned long> clusterAccesses;
+    std::vector<unsigned long> clusterMisses;
+    std::vector<unsigned long> clusterCycles;
+
+    // Half width of the 95% confidence interval of the ratio of 'values' to accesses
+    double getHalfInterval(const std::vector<unsigned long> &values) const;
+
+  public:
+    // 'ratio' is a power of two
+    SetSampler(const CacheModel &model, unsigned int ratio, bool hashed);
+
+    // Returns whether the access is simulated, and its address in the sampled hierarchy
+    bool sample(unsigned long address, unsigned long &sampledAddress) {
+        unsigned long line = address >> lineBits;
+        int position = positions[line & groupMask];
+        accesses++;
+        if ( position < 0 ) {
+            return false;
+        }
+        unsigned long sampledLine = (line >> groupBits) * keptPerGroup + position;
+        sampledAddress = (sampledLine << lineBits) | (address & ((1UL << lineBits) - 1));
+        return true;
+    }
+
+    // Counters start again from zero, e.g. at the end of the warmup
+    void resetStats();
+
+    // Result of a sampled access
+    void record(unsigned long sampledAddress, bool miss, unsigned long cycles) {
+        unsigned int cluster = (sampledAddress >> lineBits) % SAMPLE_CLUSTERS;
+        sampledAccesses++;
+        clusterAccesses[cluster]++;
+        clusterMisses[cluster] += miss;
+        clusterCycles[cluster] += cycles;
+    }
+
+    // Estimate of the full simulation from a sampled count
+    unsigned long scale(unsigned long sampledCount) const {
+        return sampledAccesses ? (unsigned long) ((double) sampledCount * accesses / sampledAccesses + 0.5) : 0;
+    }
+
+    unsigned long getAccesses() const {
+        return accesses;
+    }
+
+    unsigned long getSampledAccesses() const {
+        return sampledAccesses;
+    }
+
+    // 95% confidence intervals of the total misses and cycles
+    double getMissesInterval() const {
+        return getHalfInterval(clusterMisses) * accesses;
+    }
+
+    double getCyclesInterval() const {
+        return getHalfInterval(clusterCycles) * accesses;
+    }
+};
+
+#endif
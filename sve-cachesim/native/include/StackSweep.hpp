@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STACKSWEEP_HPP
+#define STACKSWEEP_HPP
+
+#include <ostream>
+#include <vector>
+
+/*
+ * Mattson stack-distance sweep of one cache level
+ *
+ * Every LRU cache with the same number of sets sees the same per-set stack
+ * distances, and a line hits in a cache with A ways if its distance is below A.
+ * So a single LRU stack per distinct number of sets gives the hits of all the
+ * sizes and associativities of the sweep in one pass.
+ */
+class StackSweep {
+    // All the configurations sharing a number of sets
+    struct SetGroup {
+        unsigned long numSets;
+        // Largest associativity of the group, stacks are cut at this depth
+        unsigned int depth;
+        // Most recently used line first, INVALID_LINE if empty
+        std::vector<unsigned long> stacks;
+        // Accesses at every stack distance, the last entry counts the deeper ones
+        std::vector<unsigned long> distances;
+    };
+
+    struct Configuration {
+        unsigned long cacheSize;
+        unsigned int ways;
+        unsigned int group;
+    };
+
+    unsigned int lineBits;
+    bool compatIndexing;
+    unsigned long accesses;
+    std::vector<SetGroup> groups;
+    std::vector<Configuration> configurations;
+
+  public:
+    static const unsigned long INVALID_LINE = ~0UL;
+
+    // Sizes and associativities are powers of two. Configurations without a full set are skipped
+    StackSweep(unsigned int lineBytes, unsigned long minSize, unsigned long maxSize,
+        unsigned int minWays, unsigned int maxWays, bool compatIndexing);
+
+    void access(unsigned long address) {
+        unsigned long line = address >> lineBits;
+        unsigned long index = compatIndexing ? (line << lineBits) : line;
+        accesses++;
+        for ( unsigned int i = 0; i < groups.size(); i++ ) {
+            SetGroup &group = groups[i];
+            unsigned long *stack = &group.stacks[(index & (group.numSets - 1)) * group.depth];
+            unsigned int distance = 0;
+            while ( distance < group.depth && stack[distance] != line ) {
+                distance++;
+            }
+            group.distances[distance]++;
+            // Move the line to the top of the stack, dropping the bottom one on a miss
+            unsigned int last = (distance < group.depth) ? distance : group.depth - 1;
+            for ( unsigned int j = last; j > 0; j-- ) {
+                stack[j] = stack[j - 1];
+            }
+            stack[0] = line;
+        }
+    }
+
+    unsigned int getNumConfigurations() const {
+        return configurations.size();
+    }
+
+    // One CSV line per configuration, smallest sizes first
+    void printReport(std::ostream &os) const;
+};
+
+#endif
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TIMINGMODEL_HPP
+#define TIMINGMODEL_HPP
+
+#include "CacheModel.hpp"
+
+#include <vector>
+
+/*
+ * Memory-level parallelism model
+ *
+ * Accesses issue in order, one per cycle, but an access cannot issue before the
+ * one "window" accesses older has completed (a ring of completion cycles). A miss
+ * in a level holds one of its MSHRs until the data comes back, and waits for the
+ * earliest one to be free if all of them are busy (a min-heap of free cycles per
+ * level). Independent misses therefore overlap, instead of adding up their
+ * latencies as Total Cycles does in sve-cachesim.py.
+ */
+class TimingModel {
+    std::vector<std::vector<unsigned long>> mshrs;
+    std::vector<unsigned long> window;
+    unsigned int windowHead;
+    unsigned int memoryLineBytes;
+
+    unsigned long nextIssue;
+    unsigned long endCycle;
+    // Cycles with at least one miss in flight, and the sum of all the miss latencies
+    unsigned long missBusyCycles;
+    unsigned long missBusyUntil;
+    unsigned long missCycles;
+    unsigned long memoryBytes;
+
+  public:
+    TimingModel(const CacheModel &model);
+
+    // Access served by 'level' (the number of levels for memory), missing all the levels above
+    void access(unsigned int level, unsigned int latency);
+
+    // Cycle the last access completes
+    unsigned long getCycles() const {
+        return endCycle;
+    }
+
+    // Average misses in flight while there is at least one
+    double getMlp() const;
+    // Bytes read from memory per cycle
+    double getBandwidth() const;
+};
+
+#endif
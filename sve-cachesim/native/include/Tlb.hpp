@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TLB_HPP
+#define TLB_HPP
+
+#include "CacheModel.hpp"
+#include "Cache.hpp"
+
+#include <vector>
+
+enum accessClass { LOAD_ACCESS = 0,
+    STORE_ACCESS = 1,
+    GATHER_ACCESS = 2,
+    SCATTER_ACCESS = 3,
+    NUM_ACCESS_CLASSES = 4
+};
+
+// Translations of one access class
+struct TlbStats {
+    unsigned long accesses;
+    // Hits of every TLB level, the rest are page walks
+    std::vector<unsigned long> hits;
+    unsigned long pageWalks;
+    unsigned long cycles;
+};
+
+/*
+ * TLB hierarchy, translating every access before it goes to the caches
+ *
+ * Every level is a cache of page numbers with LRU replacement. A translation
+ * costs the miss penalty of every level that misses, plus the latency of the
+ * level that hits. Missing all of them adds the page walk (the miss penalty of
+ * the last level) and fills all the levels.
+ */
+class Tlb {
+    std::vector<TlbConfig> configs;
+    std::vector<Cache> levels;
+    TlbStats stats[NUM_ACCESS_CLASSES];
+
+  public:
+    Tlb(const CacheModel &model);
+
+    // Returns the cycles of the translation
+    unsigned int translate(unsigned long address, accessClass type) {
+        TlbStats &classStats = stats[type];
+        unsigned int cycles = 0;
+        classStats.accesses++;
+        for ( unsigned int level = 0; level < levels.size(); level++ ) {
+            Cache &tlb = levels[level];
+            unsigned long page = tlb.getLine(address);
+            unsigned long set = tlb.getSet(page);
+            int way = tlb.find(page, set);
+            if ( way >= 0 ) {
+                tlb.touch(set, way);
+                classStats.hits[level]++;
+                cycles += configs[level].latency;
+                classStats.cycles += cycles;
+                return cycles;
+            }
+            unsigned long victimPage;
+            bool victimDirty;
+            tlb.fill(page, set, false, victimPage, victimDirty);
+            cycles += configs[level].missPenalty;
+        }
+        classStats.pageWalks++;
+        classStats.cycles += cycles;
+        return cycles;
+    }
+
+    unsigned int getNumLevels() const {
+        return levels.size();
+    }
+
+    // Counters start again from zero, e.g. at the end of the warmup
+    void resetStats();
+
+    const TlbStats &getStats(accessClass type) const {
+        return stats[type];
+    }
+
+    // Name of the access class in the report
+    static const char *getClassName(accessClass type);
+};
+
+#endif
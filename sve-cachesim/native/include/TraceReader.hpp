@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRACEREADER_HPP
+#define TRACEREADER_HPP
+
+#include "Utils.hpp"
+
+#include <istream>
+#include <vector>
+#include <pthread.h>
+
+/*
+ * Streams a memory trace through a bounded buffer of parsed chunks.
+ * A reader thread parses lines while the caller simulates the previous chunks,
+ * so memory use depends on the buffer size and not on the trace length.
+ */
+class TraceReader {
+    std::istream &input;
+    unsigned int chunkRecords;
+
+    // Ring of chunks, filled by the reader thread and emptied by next()
+    std::vector<std::vector<memRecord> > slots;
+    unsigned int head;
+    unsigned int tail;
+    unsigned int fullSlots;
+    bool finished;
+
+    pthread_t readerThread;
+    bool running;
+    pthread_mutex_t mutex;
+    pthread_cond_t notEmpty;
+    pthread_cond_t notFull;
+
+    static void *readTrace(void *reader);
+    void push(std::vector<memRecord> &chunk);
+
+  public:
+    TraceReader(std::istream &input, unsigned int bufferedChunks, unsigned int chunkRecords);
+    ~TraceReader();
+
+    // Launches the reader thread
+    void start();
+    // Swaps the next chunk of records into 'chunk'. Returns false at the end of the trace
+    bool next(std::vector<memRecord> &chunk);
+};
+
+#endif
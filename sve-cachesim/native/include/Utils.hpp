@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef UTILS_HPP
+#define UTILS_HPP
+
+#include <string>
+#include <cstdlib>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+enum lineFields { SEQ_NUMBER = 0,
+    THREAD_ID = 1,
+    IS_BUNDLE = 2,
+    IS_WRITE = 3,
+    DATA_SIZE = 4,
+    DATA_ADDRESS = 5,
+    PC = 6
+};
+
+// All the fields of a trace line, already converted to integers
+struct memRecord {
+    unsigned long seqNumber;
+    unsigned int threadId;
+    unsigned int isBundle;
+    unsigned int isWrite;
+    unsigned int dataSize;
+    unsigned long dataAddress;
+    unsigned long pc;
+};
+
+// Parse SVE and aarch64 lines alike, without building intermediate strings.
+// Returns false for lines that do not carry a memory access (e.g. start/stop markers)
+inline bool parseLine ( const std::string &line, memRecord &record ) {
+    const char *str = line.c_str();
+    char *end;
+    unsigned long fields[PC + 1];
+
+    for ( int i = SEQ_NUMBER; i <= PC; i++ ) {
+        fields[i] = std::strtoul(str, &end, 0);
+        if ( end == str ) {
+            return false;
+        }
+        // Skip the ':' or ',' separator
+        str = end + 1;
+    }
+
+    record.seqNumber = fields[SEQ_NUMBER];
+    record.threadId = fields[THREAD_ID];
+    record.isBundle = fields[IS_BUNDLE];
+    record.isWrite = fields[IS_WRITE];
+    record.dataSize = fields[DATA_SIZE];
+    record.dataAddress = fields[DATA_ADDRESS];
+    record.pc = fields[PC];
+    return true;
+}
+
+/*
+ * Binary snapshot helpers. Vectors are stored with their length, and only read back
+ * into vectors of the same length
+ */
+template <typename T>
+void writeValue ( std::ostream &os, const T &value ) {
+    os.write((const char *) &value, sizeof(T));
+}
+
+template <typename T>
+bool readValue ( std::istream &is, T &value ) {
+    return (bool) is.read((char *) &value, sizeof(T));
+}
+
+template <typename T>
+void writeVector ( std::ostream &os, const std::vector<T> &values ) {
+    writeValue(os, (unsigned long) values.size());
+    os.write((const char *) values.data(), values.size() * sizeof(T));
+}
+
+template <typename T>
+bool readVector ( std::istream &is, std::vector<T> &values ) {
+    unsigned long size;
+    if ( !readValue(is, size) || size != values.size() ) {
+        return false;
+    }
+    return (bool) is.read((char *) values.data(), values.size() * sizeof(T));
+}
+
+inline void writeString ( std::ostream &os, const std::string &value ) {
+    writeValue(os, (unsigned long) value.size());
+    os.write(value.data(), value.size());
+}
+
+inline bool readString ( std::istream &is, std::string &value ) {
+    unsigned long size;
+    if ( !readValue(is, size) || size > (1UL << 32) ) {
+        return false;
+    }
+    value.resize(size);
+    return (bool) is.read(&value[0], size);
+}
+
+#endif
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "AccessSplitter.hpp"
+
+#include <algorithm>
+
+AccessSplitter::AccessSplitter(unsigned int lineBytes, bool coalescing, bool keepStores) {
+    this->lineBytes = lineBytes;
+    this->coalescing = coalescing;
+    this->keepStores = keepStores;
+    lineBits = 0;
+    while ( (1U << lineBits) < lineBytes ) {
+        lineBits++;
+    }
+    resetStats();
+}
+
+void AccessSplitter::splitRecord(const memRecord &record, std::vector<Access> &accesses) {
+    Access access = { record.dataAddress, 0, record.threadId, record.pc, record.isWrite != 0,
+        record.isBundle != 0, 0 };
+
+    if ( !coalescing ) {
+        // Same chunks as sve-cachesim.py, at least one request
+        long size = record.dataSize;
+        do {
+            access.bytes = size < (long) lineBytes ? size : lineBytes;
+            accesses.push_back(access);
+            access.address += lineBytes;
+            size -= lineBytes;
+        } while ( size > 0 );
+        return;
+    }
+
+    // One request per line touched
+    unsigned long end = record.dataAddress + (record.dataSize > 0 ? record.dataSize : 1);
+    while ( access.address < end ) {
+        unsigned long lineEnd = ((access.address >> lineBits) + 1) << lineBits;
+        access.bytes = std::min(lineEnd, end) - access.address;
+        accesses.push_back(access);
+        access.address = lineEnd;
+    }
+}
+
+void AccessSplitter::flushBundle(std::vector<Access> &accesses) {
+    if ( bundle.empty() ) {
+        return;
+    }
+    bundles++;
+    elements += bundle.size();
+
+    // Distinct lines, in the order the elements touch them, and the bytes of the elements in each
+    bundleLines.clear();
+    bundleBytes.clear();
+    for ( unsigned int i = 0; i < bundle.size(); i++ ) {
+        const memRecord &element = bundle[i];
+        unsigned long end = element.dataAddress + element.dataSize;
+        unsigned long first = element.dataAddress >> lineBits;
+        unsigned long last = (element.dataAddress + (element.dataSize > 0 ? element.dataSize - 1 : 0)) >> lineBits;
+        for ( unsigned long line = first; line <= last; line++ ) {
+            uncoalescedRequests++;
+            unsigned long lineStart = line << lineBits;
+            unsigned long lineEnd = lineStart + lineBytes;
+            unsigned int bytes = std::min(lineEnd, end) - std::max(lineStart, (unsigned long) element.dataAddress);
+            if ( element.dataSize == 0 ) {
+                bytes = 0;
+            }
+            std::vector<unsigned long>::iterator it = std::find(bundleLines.begin(), bundleLines.end(), line);
+            if ( it == bundleLines.end() ) {
+                bundleLines.push_back(line);
+                bundleBytes.push_back(bytes);
+            } else {
+                unsigned int &lineBytesSoFar = bundleBytes[it - bundleLines.begin()];
+                lineBytesSoFar = std::min(lineBytesSoFar + bytes, lineBytes);
+            }
+        }
+    }
+
+    const memRecord &first = bundle[0];
+    for ( unsigned int i = 0; i < bundleLines.size(); i++ ) {
+        Access access = { bundleLines[i] << lineBits, bundleBytes[i], first.threadId, first.pc, first.isWrite != 0, true,
+            i == 0 ? (unsigned int) bundle.size() : 0 };
+        accesses.push_back(access);
+    }
+    coalescedRequests += bundleLines.size();
+    bundle.clear();
+}
+
+void AccessSplitter::split(const std::vector<memRecord> &records, std::vector<Access> &accesses) {
+    for ( unsigned int i = 0; i < records.size(); i++ ) {
+        const memRecord &record = records[i];
+        if ( coalescing && (record.isBundle & 0x1) != 0 ) {
+            // A new bundle starts, even if the previous one never ended
+            flushBundle(accesses);
+        }
+        if ( coalescing && record.isBundle != 0 ) {
+            if ( record.isWrite == 0 || keepStores ) {
+                bundle.push_back(record);
+            }
+            if ( (record.isBundle & 0x4) != 0 ) {
+                flushBundle(accesses);
+            }
+            continue;
+        }
+        if ( !bundle.empty() ) {
+            flushBundle(accesses);
+        }
+        if ( record.isWrite != 0 && !keepStores ) {
+            continue;
+        }
+        splitRecord(record, accesses);
+    }
+}
+
+void AccessSplitter::finish(std::vector<Access> &accesses) {
+    flushBundle(accesses);
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Cache.hpp"
+#include "Utils.hpp"
+
+#include <sstream>
+
+Cache::Cache(const CacheConfig &config, bool compatIndexing) {
+    this->config = config;
+    this->compatIndexing = compatIndexing;
+    ways = config.setSize;
+    stride = (ways + TAG_LANES - 1) / TAG_LANES * TAG_LANES;
+    lineBits = 0;
+    while ( (1U << lineBits) < config.lineBytes() ) {
+        lineBits++;
+    }
+    numSets = config.cacheSize / ((unsigned long) ways * config.lineBytes());
+    powerOfTwoSets = (numSets & (numSets - 1)) == 0;
+    setMask = numSets - 1;
+
+    tags = std::vector<unsigned long>(numSets * stride, INVALID_LINE);
+    dirty = std::vector<unsigned char>(numSets * stride, 0);
+    prefetched = std::vector<unsigned char>(numSets * stride, 0);
+    readyCycle = std::vector<unsigned long>(numSets * stride, 0);
+    filledWays = std::vector<unsigned int>(numSets, 0);
+    invalidWays = std::vector<unsigned int>(numSets, 0);
+    policy = std::unique_ptr<ReplacementPolicy>(ReplacementPolicy::create(config.replacement, numSets, ways));
+}
+
+void Cache::save(std::ostream &os) const {
+    writeValue(os, numSets);
+    writeValue(os, ways);
+    writeValue(os, lineBits);
+    writeVector(os, tags);
+    writeVector(os, dirty);
+    writeVector(os, filledWays);
+    writeVector(os, invalidWays);
+    std::stringstream policyState;
+    policy->save(policyState);
+    writeString(os, config.replacement);
+    writeString(os, policyState.str());
+}
+
+bool Cache::load(std::istream &is, std::string &error) {
+    unsigned long savedSets;
+    unsigned int savedWays;
+    unsigned int savedLineBits;
+    if ( !readValue(is, savedSets) || !readValue(is, savedWays) || !readValue(is, savedLineBits) ) {
+        error = "truncated snapshot";
+        return false;
+    }
+    if ( savedSets != numSets || savedWays != ways || savedLineBits != lineBits ) {
+        error = "level " + std::to_string(config.level) + " has another size, associativity or line size than in the snapshot";
+        return false;
+    }
+    std::string replacement;
+    std::string policyState;
+    if ( !readVector(is, tags) || !readVector(is, dirty) || !readVector(is, filledWays) || !readVector(is, invalidWays)
+        || !readString(is, replacement) || !readString(is, policyState) ) {
+        error = "truncated snapshot";
+        return false;
+    }
+    prefetched = std::vector<unsigned char>(numSets * stride, 0);
+
+    std::stringstream policyStream(policyState);
+    if ( replacement == config.replacement && policy->load(policyStream) ) {
+        return true;
+    }
+    // Another policy: start from a fresh state, with the lines inserted in way order
+    policy = std::unique_ptr<ReplacementPolicy>(ReplacementPolicy::create(config.replacement, numSets, ways));
+    for ( unsigned long set = 0; set < numSets; set++ ) {
+        for ( unsigned int way = 0; way < filledWays[set]; way++ ) {
+            if ( tags[set * stride + way] != INVALID_LINE ) {
+                policy->insert(set, way);
+            }
+        }
+    }
+    return true;
+}
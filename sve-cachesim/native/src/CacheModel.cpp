@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "CacheModel.hpp"
+#include "ReplacementPolicy.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+
+#define DEFAULT_MSHRS 8
+#define DEFAULT_WINDOW 128
+
+/*
+ * Private functions
+ */
+bool readUnsigned(const JsonValue &object, const std::string &key, unsigned long &value, std::string &error) {
+    if ( !object.has(key) || !object[key].isNumber() || object[key].getNumber() < 0 ) {
+        error = "missing or wrong \"" + key + "\"";
+        return false;
+    }
+    value = (unsigned long) object[key].getNumber();
+    return true;
+}
+
+// Optional write policy keys. 'found' is set if any of them is present
+bool readWritePolicy(const JsonValue &object, CacheConfig &config, bool &found, std::string &error) {
+    config.writeBack = true;
+    config.writeAllocate = true;
+    if ( object.has("writepolicy") ) {
+        const JsonValue &policy = object["writepolicy"];
+        if ( policy.isString() && policy.getString() == "writeback" ) {
+            config.writeBack = true;
+        } else if ( policy.isString() && policy.getString() == "writethrough" ) {
+            config.writeBack = false;
+        } else {
+            error = "\"writepolicy\" of level " + std::to_string(config.level) + " must be \"writeback\" or \"writethrough\"";
+            return false;
+        }
+        found = true;
+    }
+    if ( object.has("writealloc") ) {
+        if ( !object["writealloc"].isBool() ) {
+            error = "\"writealloc\" of level " + std::to_string(config.level) + " must be true or false";
+            return false;
+        }
+        config.writeAllocate = object["writealloc"].getBool();
+        found = true;
+    }
+    return true;
+}
+
+bool readLevel(const JsonValue &object, CacheConfig &config, bool &storesEnabled, bool &inclusionEnabled, std::string &error) {
+    unsigned long value;
+    if ( !readUnsigned(object, "level", value, error) ) return false;
+    config.level = value;
+    if ( !readUnsigned(object, "cachesize", value, error) ) return false;
+    config.cacheSize = value;
+    if ( !readUnsigned(object, "linesize", value, error) ) return false;
+    config.lineSize = value;
+    if ( !readUnsigned(object, "setsize", value, error) ) return false;
+    config.setSize = value;
+    if ( !readUnsigned(object, "wordsize", value, error) ) return false;
+    config.wordSize = value;
+    if ( !readUnsigned(object, "latency", value, error) ) return false;
+    config.latency = value;
+    if ( !readUnsigned(object, "memlatency", value, error) ) return false;
+    config.memLatency = value;
+    if ( !readWritePolicy(object, config, storesEnabled, error) ) return false;
+
+    config.replacement = "fifo";
+    if ( object.has("replacement") ) {
+        if ( !object["replacement"].isString() || !ReplacementPolicy::isValid(object["replacement"].getString()) ) {
+            error = "\"replacement\" of level " + std::to_string(config.level) + " must be one of fifo, lru, plru, srrip, brrip or random";
+            return false;
+        }
+        config.replacement = object["replacement"].getString();
+    }
+
+    // Relationship with the levels above, non-inclusive non-exclusive by default
+    config.inclusive = false;
+    config.exclusive = false;
+    if ( object.has("inclusion") ) {
+        const JsonValue &inclusion = object["inclusion"];
+        if ( inclusion.isString() && inclusion.getString() == "inclusive" ) {
+            config.inclusive = true;
+        } else if ( inclusion.isString() && inclusion.getString() == "exclusive" ) {
+            config.exclusive = true;
+        } else if ( !inclusion.isString() || inclusion.getString() != "nine" ) {
+            error = "\"inclusion\" of level " + std::to_string(config.level) + " must be \"inclusive\", \"exclusive\" or \"nine\"";
+            return false;
+        }
+        inclusionEnabled = true;
+    }
+
+    config.mshrs = DEFAULT_MSHRS;
+    if ( object.has("mshrs") ) {
+        if ( !readUnsigned(object, "mshrs", value, error) ) return false;
+        if ( value == 0 ) {
+            error = "level " + std::to_string(config.level) + " needs at least one MSHR";
+            return false;
+        }
+        config.mshrs = value;
+    }
+
+    unsigned int lineBytes = config.lineBytes();
+    if ( lineBytes == 0 || (lineBytes & (lineBytes - 1)) != 0 ) {
+        error = "the line size (linesize * wordsize) of level " + std::to_string(config.level) + " must be a power of two";
+        return false;
+    }
+    if ( config.setSize == 0 || config.cacheSize / ((unsigned long) config.setSize * lineBytes) == 0 ) {
+        error = "level " + std::to_string(config.level) + " is too small to hold a single set";
+        return false;
+    }
+    if ( config.setSize > ReplacementPolicy::getMaxWays(config.replacement) ) {
+        error = "the " + config.replacement + " policy of level " + std::to_string(config.level) + " supports up to "
+            + std::to_string(ReplacementPolicy::getMaxWays(config.replacement)) + " ways";
+        return false;
+    }
+    return true;
+}
+
+bool readTlbLevel(const JsonValue &object, TlbConfig &config, std::string &error) {
+    unsigned long value;
+    if ( !readUnsigned(object, "tlblevel", value, error) ) return false;
+    config.level = value;
+    if ( !readUnsigned(object, "entries", value, error) ) return false;
+    config.entries = value;
+    if ( !readUnsigned(object, "setsize", value, error) ) return false;
+    config.setSize = value;
+    if ( !readUnsigned(object, "pagesize", value, error) ) return false;
+    config.pageSize = value;
+    if ( !readUnsigned(object, "latency", value, error) ) return false;
+    config.latency = value;
+    if ( !readUnsigned(object, "misspenalty", value, error) ) return false;
+    config.missPenalty = value;
+
+    if ( config.pageSize == 0 || (config.pageSize & (config.pageSize - 1)) != 0 || config.pageSize > (1UL << 31) ) {
+        error = "the page size of TLB level " + std::to_string(config.level) + " must be a power of two";
+        return false;
+    }
+    if ( config.setSize == 0 || config.entries == 0 || config.entries % config.setSize != 0 ) {
+        error = "the entries of TLB level " + std::to_string(config.level) + " must be a multiple of its setsize";
+        return false;
+    }
+    if ( config.setSize > ReplacementPolicy::getMaxWays("lru") ) {
+        error = "TLB level " + std::to_string(config.level) + " supports up to "
+            + std::to_string(ReplacementPolicy::getMaxWays("lru")) + " ways";
+        return false;
+    }
+    return true;
+}
+
+/*
+ * Public functions
+ */
+CacheModel::CacheModel() {
+    name = std::string();
+    levels = std::vector<CacheConfig>();
+    tlbLevels = std::vector<TlbConfig>();
+    fetchLevel = -1;
+    fetchLevelLatency = 0;
+    prefetchDegree = 1;
+    prefetchDistance = 1;
+    storesEnabled = false;
+    inclusionEnabled = false;
+    window = DEFAULT_WINDOW;
+}
+
+bool CacheModel::load(const std::string &fileName, std::string &error) {
+    std::ifstream file(fileName);
+    if ( !file ) {
+        error = "cannot open " + fileName;
+        return false;
+    }
+    std::stringstream contents;
+    contents << file.rdbuf();
+
+    JsonValue model;
+    if ( !model.parse(contents.str(), error) ) {
+        return false;
+    }
+    if ( !model.isArray() ) {
+        error = "the model must be a JSON array";
+        return false;
+    }
+
+    unsigned long numLevels = 0;
+    bool foundNumLevels = false;
+    for ( unsigned int i = 0; i < model.size(); i++ ) {
+        const JsonValue &object = model[i];
+        if ( !object.isObject() ) {
+            error = "all the elements of the model must be objects";
+            return false;
+        }
+        if ( object.has("nlevels") ) {
+            if ( !readUnsigned(object, "nlevels", numLevels, error) ) return false;
+            foundNumLevels = true;
+            if ( object.has("window") ) {
+                unsigned long value;
+                if ( !readUnsigned(object, "window", value, error) ) return false;
+                if ( value == 0 ) {
+                    error = "\"window\" must hold at least one access";
+                    return false;
+                }
+                window = value;
+            }
+        } else if ( object.has("level") ) {
+            CacheConfig config;
+            if ( !readLevel(object, config, storesEnabled, inclusionEnabled, error) ) return false;
+            levels.push_back(config);
+        } else if ( object.has("tlblevel") ) {
+            TlbConfig config;
+            if ( !readTlbLevel(object, config, error) ) return false;
+            tlbLevels.push_back(config);
+        } else if ( object.has("fetch_level") ) {
+            unsigned long value;
+            if ( !readUnsigned(object, "fetch_level", value, error) ) return false;
+            fetchLevel = (int) value - 1;
+            if ( object.has("fetch_level_latency") ) {
+                if ( !readUnsigned(object, "fetch_level_latency", value, error) ) return false;
+                fetchLevelLatency = value;
+            }
+            if ( object.has("prefetch_degree") ) {
+                if ( !readUnsigned(object, "prefetch_degree", value, error) ) return false;
+                prefetchDegree = value;
+            }
+            if ( object.has("prefetch_distance") ) {
+                if ( !readUnsigned(object, "prefetch_distance", value, error) ) return false;
+                prefetchDistance = value;
+            }
+        }
+    }
+
+    if ( !foundNumLevels || numLevels != levels.size() || numLevels == 0 ) {
+        error = "\"nlevels\" does not match the number of levels in the model";
+        return false;
+    }
+    std::sort(levels.begin(), levels.end(), [](const CacheConfig &a, const CacheConfig &b) {
+        return a.level < b.level;
+    });
+    for ( unsigned int i = 0; i < levels.size(); i++ ) {
+        if ( levels[i].level != i + 1 ) {
+            error = "levels must be numbered from 1 to nlevels";
+            return false;
+        }
+    }
+    if ( levels[0].exclusive ) {
+        error = "level 1 has no level above to be exclusive of";
+        return false;
+    }
+    for ( unsigned int i = 1; i < levels.size(); i++ ) {
+        if ( levels[i].exclusive && levels[i].lineBytes() != levels[i - 1].lineBytes() ) {
+            error = "exclusive level " + std::to_string(i + 1) + " must have the line size of the level above";
+            return false;
+        }
+    }
+    std::sort(tlbLevels.begin(), tlbLevels.end(), [](const TlbConfig &a, const TlbConfig &b) {
+        return a.level < b.level;
+    });
+    for ( unsigned int i = 0; i < tlbLevels.size(); i++ ) {
+        if ( tlbLevels[i].level != i + 1 ) {
+            error = "TLB levels must be numbered from 1";
+            return false;
+        }
+    }
+    if ( fetchLevel >= (int) levels.size() ) {
+        error = "\"fetch_level\" is not a level of the model";
+        return false;
+    }
+
+    // Same run name as sve-cachesim.py
+    name = fileName.substr(0, fileName.find(".json"));
+    name = name.substr(name.find_last_of('/') + 1);
+    return true;
+}
+
+bool CacheModel::sampleSets(unsigned int ratio, std::string &error) {
+    for ( unsigned int i = 0; i < levels.size(); i++ ) {
+        CacheConfig &config = levels[i];
+        config.cacheSize /= ratio;
+        if ( config.cacheSize / ((unsigned long) config.setSize * config.lineBytes()) == 0 ) {
+            error = "level " + std::to_string(config.level) + " has fewer sets than the sampling ratio";
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string CacheModel::getName() const {
+    return name;
+}
+
+unsigned int CacheModel::getNumLevels() const {
+    return levels.size();
+}
+
+const CacheConfig &CacheModel::getLevel(unsigned int level) const {
+    return levels[level];
+}
+
+unsigned int CacheModel::getNumTlbLevels() const {
+    return tlbLevels.size();
+}
+
+const TlbConfig &CacheModel::getTlbLevel(unsigned int level) const {
+    return tlbLevels[level];
+}
+
+int CacheModel::getFetchLevel() const {
+    return fetchLevel;
+}
+
+unsigned int CacheModel::getFetchLevelLatency() const {
+    return fetchLevelLatency;
+}
+
+unsigned int CacheModel::getPrefetchDegree() const {
+    return prefetchDegree;
+}
+
+unsigned int CacheModel::getPrefetchDistance() const {
+    return prefetchDistance;
+}
+
+bool CacheModel::simulatesStores() const {
+    return storesEnabled;
+}
+
+bool CacheModel::hasInclusionPolicies() const {
+    return inclusionEnabled;
+}
+
+unsigned int CacheModel::getWindow() const {
+    return window;
+}
@@ -0,0 +1,517 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Hierarchy.hpp"
+#include "Utils.hpp"
+
+#include <pthread.h>
+#include <fstream>
+
+#define SNAPSHOT_MAGIC "SVECSIM-SNAPSHOT-2"
+
+Hierarchy::Hierarchy(const CacheModel &model, bool compatIndexing) {
+    for ( unsigned int level = 0; level < model.getNumLevels(); level++ ) {
+        levels.push_back(Cache(model.getLevel(level), compatIndexing));
+    }
+    stats = std::vector<LevelStats>(levels.size(), LevelStats());
+    inclusionPolicies = false;
+    for ( unsigned int level = 0; level < levels.size(); level++ ) {
+        const CacheConfig &config = levels[level].getConfig();
+        inclusionPolicies = inclusionPolicies || config.inclusive || config.exclusive;
+    }
+    memReadBytes = 0;
+    memWriteBytes = 0;
+    fetchLevel = model.getFetchLevel();
+    prefetchStats = PrefetchStats();
+    cycle = 0;
+    deferVictims = false;
+}
+
+/*
+ * Brings a line into a level and returns its way. The victim is evicted
+ */
+unsigned int Hierarchy::fillLine(unsigned int level, unsigned long line, unsigned long set, bool isDirty) {
+    Cache &cache = levels[level];
+    unsigned long victim;
+    bool victimDirty;
+    unsigned int way = cache.fill(line, set, isDirty, victim, victimDirty);
+    if ( victim != Cache::INVALID_LINE ) {
+        stats[level].replacements++;
+        evictLine(level, cache.getAddress(victim), victimDirty);
+    }
+    return way;
+}
+
+/*
+ * A line replaced in a level goes to the next one if it is exclusive, otherwise it is
+ * written back if dirty. An inclusive level removes it from the levels above first
+ */
+void Hierarchy::evictLine(unsigned int level, unsigned long address, bool isDirty) {
+    if ( levels[level].getConfig().inclusive && backInvalidate(level, address) ) {
+        isDirty = true;
+    }
+    if ( level + 1 < levels.size() && levels[level + 1].getConfig().exclusive ) {
+        if ( deferVictims ) {
+            pendingVictims.push_back(PendingVictim{ level + 1, address, isDirty });
+            return;
+        }
+        fillVictim(level + 1, address, isDirty);
+    } else if ( isDirty ) {
+        stats[level].writebacks++;
+        writeLine(level + 1, address, levels[level].getConfig().lineBytes());
+    }
+}
+
+/*
+ * Removes the copies of a line of 'level' from all the levels above.
+ * Returns whether any of them was modified
+ */
+bool Hierarchy::backInvalidate(unsigned int level, unsigned long address) {
+    unsigned long end = address + levels[level].getConfig().lineBytes();
+    bool isDirty = false;
+    for ( unsigned int upper = 0; upper < level; upper++ ) {
+        Cache &cache = levels[upper];
+        for ( unsigned long part = address; part < end; part += cache.getConfig().lineBytes() ) {
+            unsigned long line = cache.getLine(part);
+            unsigned long set = cache.getSet(line);
+            int way = cache.find(line, set);
+            if ( way >= 0 ) {
+                isDirty = isDirty || cache.isDirty(set, way);
+                cache.invalidate(set, way);
+                stats[level].backInvalidations++;
+            }
+        }
+    }
+    return isDirty;
+}
+
+/*
+ * Moves a line hit in an exclusive level to the closest level above that got it.
+ * Returns whether it moved, and its level, set and way there
+ */
+bool Hierarchy::moveUp(unsigned int level, unsigned long address, unsigned long set, int way,
+    unsigned int &upperLevel, unsigned long &upperSet, int &upperWay) {
+    Cache &cache = levels[level];
+    for ( upperLevel = level; upperLevel-- > 0; ) {
+        Cache &upper = levels[upperLevel];
+        unsigned long upperLine = upper.getLine(address);
+        upperSet = upper.getSet(upperLine);
+        upperWay = upper.find(upperLine, upperSet);
+        if ( upperWay < 0 ) {
+            continue;
+        }
+        if ( cache.isDirty(set, way) ) {
+            upper.setDirty(upperSet, upperWay);
+        }
+        cache.invalidate(set, way);
+        return true;
+    }
+    return false;
+}
+
+/*
+ * Puts the victim of the level above into an exclusive level
+ */
+void Hierarchy::fillVictim(unsigned int level, unsigned long address, bool isDirty) {
+    Cache &cache = levels[level];
+    unsigned long line = cache.getLine(address);
+    unsigned long set = cache.getSet(line);
+    int way = cache.find(line, set);
+    stats[level].victimFills++;
+    if ( way >= 0 ) {
+        // A copy can be left here, e.g. by a store that was not allocated above
+        cache.touch(set, way);
+        if ( isDirty ) {
+            cache.setDirty(set, way);
+        }
+        return;
+    }
+    fillLine(level, line, set, isDirty);
+}
+
+/*
+ * Victim fills left by a demand access, in the order the victims were replaced
+ */
+void Hierarchy::fillPendingVictims() {
+    deferVictims = false;
+    for ( unsigned int i = 0; i < pendingVictims.size(); i++ ) {
+        fillVictim(pendingVictims[i].level, pendingVictims[i].address, pendingVictims[i].isDirty);
+    }
+    pendingVictims.clear();
+}
+
+/*
+ * Writes 'bytes' coming from the level above (a writeback or a write-through store).
+ * These are not demand accesses, so only traffic is counted
+ */
+void Hierarchy::writeLine(unsigned int level, unsigned long address, unsigned int bytes) {
+    if ( level == levels.size() ) {
+        memWriteBytes += bytes;
+        return;
+    }
+    Cache &cache = levels[level];
+    const CacheConfig &config = cache.getConfig();
+    unsigned long line = cache.getLine(address);
+    unsigned long set = cache.getSet(line);
+    int way = cache.find(line, set);
+    if ( way >= 0 ) {
+        cache.touch(set, way);
+        if ( config.writeBack ) {
+            cache.setDirty(set, way);
+            return;
+        }
+    } else if ( config.writeAllocate ) {
+        fillLine(level, line, set, config.writeBack);
+        if ( config.writeBack ) {
+            return;
+        }
+    }
+    // Write-through, or not allocated here: keep going down
+    stats[level].writebacks++;
+    writeLine(level + 1, address, bytes);
+}
+
+unsigned int Hierarchy::access(unsigned long address, bool isWrite, unsigned int bytes) {
+    unsigned int numLevels = levels.size();
+    deferVictims = inclusionPolicies;
+    for ( unsigned int level = 0; level < numLevels; level++ ) {
+        Cache &cache = levels[level];
+        const CacheConfig &config = cache.getConfig();
+        unsigned long line = cache.getLine(address);
+        unsigned long set = cache.getSet(line);
+        int way = cache.find(line, set);
+
+        stats[level].accesses++;
+        if ( isWrite ) {
+            stats[level].writeAccesses++;
+        }
+        if ( way >= 0 ) {
+            cache.touch(set, way);
+            stats[level].hits++;
+            if ( (int) level == fetchLevel ) {
+                checkPrefetched(cache, set, way);
+            }
+            // An exclusive level gives the line up to the level above, which got it on the way down
+            unsigned int upperLevel = 0;
+            unsigned long upperSet = 0;
+            int upperWay = 0;
+            bool moved = config.exclusive && moveUp(level, address, set, way, upperLevel, upperSet, upperWay);
+            if ( isWrite ) {
+                stats[level].writeHits++;
+                if ( config.writeBack && moved ) {
+                    levels[upperLevel].setDirty(upperSet, upperWay);
+                } else if ( config.writeBack ) {
+                    cache.setDirty(set, way);
+                } else {
+                    stats[level].writebacks++;
+                    writeLine(level + 1, address, bytes);
+                }
+            }
+            fillPendingVictims();
+            return level;
+        }
+        stats[level].evicts++;
+
+        if ( config.exclusive ) {
+            // Only the levels above get the line
+        } else if ( !isWrite ) {
+            fillLine(level, line, set, false);
+        } else if ( config.writeAllocate ) {
+            // Fetch the line and write it here. A write-through level also passes the store down,
+            // which fetches the line from below as well
+            fillLine(level, line, set, config.writeBack);
+            isWrite = !config.writeBack;
+        }
+        // Without write-allocate the store itself goes to the next level
+        if ( isWrite ) {
+            stats[level].writebacks++;
+        }
+    }
+
+    if ( isWrite ) {
+        memWriteBytes += bytes;
+    } else {
+        memReadBytes += levels.back().getConfig().lineBytes();
+    }
+    fillPendingVictims();
+    return numLevels;
+}
+
+/*
+ * Same walk as sve-cachesim.py: every level from the fetch level down that misses gets the line,
+ * and counts a prefetch evict. Hits do not update the replacement state
+ */
+void Hierarchy::prefetch(unsigned long address) {
+    unsigned int numLevels = levels.size();
+    prefetchStats.requests++;
+
+    int fetchWay = -1;
+    unsigned long fetchSet = 0;
+    unsigned int level;
+    for ( level = fetchLevel; level < numLevels; level++ ) {
+        Cache &cache = levels[level];
+        unsigned long line = cache.getLine(address);
+        unsigned long set = cache.getSet(line);
+        if ( cache.find(line, set) >= 0 ) {
+            break;
+        }
+        stats[level].prefetchEvicts++;
+        unsigned int way = fillLine(level, line, set, false);
+        if ( (int) level == fetchLevel ) {
+            fetchWay = way;
+            fetchSet = set;
+        }
+    }
+    if ( level == numLevels ) {
+        memReadBytes += levels.back().getConfig().lineBytes();
+    }
+
+    if ( fetchWay >= 0 ) {
+        prefetchStats.fills++;
+        levels[fetchLevel].setPrefetched(fetchSet, fetchWay, cycle + getLatency(level));
+    }
+}
+
+/*
+ * Same as access() and writeLine() for a single level: instead of going on to the next
+ * level, the requests for it are left in the slot, in the order access() would send them
+ */
+void Hierarchy::processRequest(unsigned int level, const Request &request, ShardState &shard,
+    RequestSlot &slot, std::vector<unsigned int> &hitLevels) {
+    Cache &cache = levels[level];
+    const CacheConfig &config = cache.getConfig();
+    LevelStats &levelStats = shard.stats[level];
+    unsigned long line = cache.getLine(request.address);
+    unsigned long set = cache.getSet(line);
+    int way = cache.find(line, set);
+    slot.count = 0;
+
+    if ( request.type == WRITEBACK_REQUEST ) {
+        if ( way >= 0 ) {
+            cache.touch(set, way);
+            if ( config.writeBack ) {
+                cache.setDirty(set, way);
+                return;
+            }
+        } else if ( config.writeAllocate ) {
+            unsigned long victim;
+            bool victimDirty;
+            cache.fill(line, set, config.writeBack, victim, victimDirty);
+            if ( victim != Cache::INVALID_LINE ) {
+                levelStats.replacements++;
+            }
+            if ( victim != Cache::INVALID_LINE && victimDirty ) {
+                levelStats.writebacks++;
+                Request writeback = { cache.getAddress(victim), config.lineBytes(), WRITEBACK_REQUEST, 0 };
+                slot.requests[slot.count++] = writeback;
+            }
+            if ( config.writeBack ) {
+                return;
+            }
+        }
+        levelStats.writebacks++;
+        slot.requests[slot.count++] = request;
+        return;
+    }
+
+    bool isWrite = (request.type == WRITE_REQUEST);
+    levelStats.accesses++;
+    if ( isWrite ) {
+        levelStats.writeAccesses++;
+    }
+    if ( way >= 0 ) {
+        cache.touch(set, way);
+        levelStats.hits++;
+        hitLevels[request.demand] = level;
+        if ( isWrite ) {
+            levelStats.writeHits++;
+            if ( config.writeBack ) {
+                cache.setDirty(set, way);
+            } else {
+                levelStats.writebacks++;
+                Request writeThrough = { request.address, request.bytes, WRITEBACK_REQUEST, 0 };
+                slot.requests[slot.count++] = writeThrough;
+            }
+        }
+        return;
+    }
+    levelStats.evicts++;
+
+    if ( !isWrite || config.writeAllocate ) {
+        bool isDirty = isWrite && config.writeBack;
+        unsigned long victim;
+        bool victimDirty;
+        cache.fill(line, set, isDirty, victim, victimDirty);
+        if ( victim != Cache::INVALID_LINE ) {
+            levelStats.replacements++;
+        }
+        if ( victim != Cache::INVALID_LINE && victimDirty ) {
+            levelStats.writebacks++;
+            Request writeback = { cache.getAddress(victim), config.lineBytes(), WRITEBACK_REQUEST, 0 };
+            slot.requests[slot.count++] = writeback;
+        }
+        if ( isWrite ) {
+            isWrite = !config.writeBack;
+        }
+    }
+    if ( isWrite ) {
+        levelStats.writebacks++;
+    }
+    Request next = { request.address, request.bytes, isWrite ? (unsigned int) WRITE_REQUEST : (unsigned int) READ_REQUEST, request.demand };
+    slot.requests[slot.count++] = next;
+}
+
+struct ShardArgs {
+    Hierarchy *hierarchy;
+    unsigned int level;
+    unsigned int shard;
+    unsigned int numShards;
+    const std::vector<Request> *requests;
+    std::vector<RequestSlot> *slots;
+    std::vector<unsigned int> *hitLevels;
+};
+
+void *Hierarchy::simulateShard(void *shardArgs) {
+    ShardArgs *args = (ShardArgs *) shardArgs;
+    Hierarchy *self = args->hierarchy;
+    const Cache &cache = self->levels[args->level];
+    const std::vector<Request> &requests = *args->requests;
+    ShardState &shard = self->shards[args->shard];
+
+    for ( unsigned int i = 0; i < requests.size(); i++ ) {
+        // Spread the sets over the shards, even when only some of them are used (e.g. -c)
+        unsigned long set = cache.getSet(cache.getLine(requests[i].address));
+        if ( ((set * 0x9E3779B97F4A7C15UL) >> 32) % args->numShards != args->shard ) {
+            continue;
+        }
+        self->processRequest(args->level, requests[i], shard, (*args->slots)[i], *args->hitLevels);
+    }
+
+    pthread_exit(NULL);
+}
+
+void Hierarchy::accessBatch(const std::vector<Request> &demands, std::vector<unsigned int> &hitLevels, unsigned int numThreads) {
+    unsigned int numLevels = levels.size();
+    if ( shards.size() != numThreads ) {
+        ShardState empty;
+        empty.stats = std::vector<LevelStats>(numLevels, LevelStats());
+        shards = std::vector<ShardState>(numThreads, empty);
+    }
+    hitLevels = std::vector<unsigned int>(demands.size(), numLevels);
+
+    std::vector<Request> requests = demands;
+    std::vector<Request> nextRequests;
+    std::vector<RequestSlot> slots;
+    pthread_t workers[numThreads];
+    ShardArgs args[numThreads];
+
+    for ( unsigned int level = 0; level < numLevels && !requests.empty(); level++ ) {
+        slots.resize(requests.size());
+        for ( unsigned int i = 0; i < numThreads; i++ ) {
+            ShardArgs shardArgs = { this, level, i, numThreads, &requests, &slots, &hitLevels };
+            args[i] = shardArgs;
+            pthread_create(&workers[i], NULL, simulateShard, (void *) &args[i]);
+        }
+        for ( unsigned int i = 0; i < numThreads; i++ ) {
+            pthread_join(workers[i], NULL);
+        }
+
+        // Requests for the next level, in the original order
+        nextRequests.clear();
+        for ( unsigned int i = 0; i < slots.size(); i++ ) {
+            for ( unsigned int j = 0; j < slots[i].count; j++ ) {
+                nextRequests.push_back(slots[i].requests[j]);
+            }
+        }
+        requests.swap(nextRequests);
+    }
+
+    // Whatever is left goes to memory
+    for ( unsigned int i = 0; i < requests.size(); i++ ) {
+        if ( requests[i].type == READ_REQUEST ) {
+            memReadBytes += levels.back().getConfig().lineBytes();
+        } else {
+            memWriteBytes += requests[i].bytes;
+        }
+    }
+
+    for ( unsigned int i = 0; i < numThreads; i++ ) {
+        ShardState &shard = shards[i];
+        for ( unsigned int level = 0; level < numLevels; level++ ) {
+            LevelStats &from = shard.stats[level];
+            LevelStats &to = stats[level];
+            to.hits += from.hits;
+            to.accesses += from.accesses;
+            to.evicts += from.evicts;
+            to.writeAccesses += from.writeAccesses;
+            to.writeHits += from.writeHits;
+            to.writebacks += from.writebacks;
+            to.replacements += from.replacements;
+            from = LevelStats();
+        }
+    }
+}
+
+void Hierarchy::resetStats() {
+    stats = std::vector<LevelStats>(levels.size(), LevelStats());
+    memReadBytes = 0;
+    memWriteBytes = 0;
+    prefetchStats = PrefetchStats();
+}
+
+bool Hierarchy::saveSnapshot(const std::string &fileName, std::string &error) const {
+    std::ofstream file(fileName, std::ios::binary);
+    if ( !file ) {
+        error = "cannot create " + fileName;
+        return false;
+    }
+    writeString(file, SNAPSHOT_MAGIC);
+    writeValue(file, (unsigned int) levels.size());
+    for ( unsigned int level = 0; level < levels.size(); level++ ) {
+        levels[level].save(file);
+    }
+    if ( !file ) {
+        error = "cannot write " + fileName;
+        return false;
+    }
+    return true;
+}
+
+bool Hierarchy::loadSnapshot(const std::string &fileName, std::string &error) {
+    std::ifstream file(fileName, std::ios::binary);
+    if ( !file ) {
+        error = "cannot open " + fileName;
+        return false;
+    }
+    std::string magic;
+    unsigned int numLevels;
+    if ( !readString(file, magic) || magic != SNAPSHOT_MAGIC || !readValue(file, numLevels) ) {
+        error = fileName + " is not a snapshot";
+        return false;
+    }
+    if ( numLevels != levels.size() ) {
+        error = "the snapshot has another number of levels";
+        return false;
+    }
+    for ( unsigned int level = 0; level < levels.size(); level++ ) {
+        if ( !levels[level].load(file, error) ) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Json.hpp"
+
+#include <cstdlib>
+#include <cctype>
+
+/*
+ * Private functions
+ */
+void skipSpaces(const std::string &text, size_t &pos) {
+    while ( pos < text.size() && std::isspace((unsigned char) text[pos]) ) {
+        pos++;
+    }
+}
+
+bool parseString(const std::string &text, size_t &pos, std::string &value, std::string &error) {
+    // pos points to the opening quote
+    pos++;
+    value.clear();
+    while ( pos < text.size() && text[pos] != '"' ) {
+        if ( text[pos] == '\\' && pos + 1 < text.size() ) {
+            pos++;
+            switch ( text[pos] ) {
+                case 'n': value.push_back('\n'); break;
+                case 't': value.push_back('\t'); break;
+                case 'r': value.push_back('\r'); break;
+                case 'b': value.push_back('\b'); break;
+                case 'f': value.push_back('\f'); break;
+                default:  value.push_back(text[pos]); break;
+            }
+        } else {
+            value.push_back(text[pos]);
+        }
+        pos++;
+    }
+    if ( pos >= text.size() ) {
+        error = "unterminated string";
+        return false;
+    }
+    pos++;
+    return true;
+}
+
+bool parseLiteral(const std::string &text, size_t &pos, const std::string &literal) {
+    if ( text.compare(pos, literal.size(), literal) == 0 ) {
+        pos += literal.size();
+        return true;
+    }
+    return false;
+}
+
+/*
+ * Public functions
+ */
+JsonValue::JsonValue() {
+    type = JSON_NULL;
+    boolValue = false;
+    numberValue = 0.0;
+}
+
+bool JsonValue::parse(const std::string &text, std::string &error) {
+    size_t pos = 0;
+    if ( !parseValue(text, pos, error) ) {
+        return false;
+    }
+    skipSpaces(text, pos);
+    if ( pos != text.size() ) {
+        error = "unexpected characters after the JSON value at offset " + std::to_string(pos);
+        return false;
+    }
+    return true;
+}
+
+bool JsonValue::parseValue(const std::string &text, size_t &pos, std::string &error) {
+    skipSpaces(text, pos);
+    if ( pos >= text.size() ) {
+        error = "unexpected end of file";
+        return false;
+    }
+
+    char c = text[pos];
+    if ( c == '{' ) {
+        type = JSON_OBJECT;
+        pos++;
+        skipSpaces(text, pos);
+        if ( pos < text.size() && text[pos] == '}' ) {
+            pos++;
+            return true;
+        }
+        while ( true ) {
+            skipSpaces(text, pos);
+            if ( pos >= text.size() || text[pos] != '"' ) {
+                error = "expected a key at offset " + std::to_string(pos);
+                return false;
+            }
+            std::string key;
+            if ( !parseString(text, pos, key, error) ) {
+                return false;
+            }
+            skipSpaces(text, pos);
+            if ( pos >= text.size() || text[pos] != ':' ) {
+                error = "expected ':' at offset " + std::to_string(pos);
+                return false;
+            }
+            pos++;
+            if ( !objectValue[key].parseValue(text, pos, error) ) {
+                return false;
+            }
+            skipSpaces(text, pos);
+            if ( pos < text.size() && text[pos] == ',' ) {
+                pos++;
+            } else if ( pos < text.size() && text[pos] == '}' ) {
+                pos++;
+                return true;
+            } else {
+                error = "expected ',' or '}' at offset " + std::to_string(pos);
+                return false;
+            }
+        }
+    } else if ( c == '[' ) {
+        type = JSON_ARRAY;
+        pos++;
+        skipSpaces(text, pos);
+        if ( pos < text.size() && text[pos] == ']' ) {
+            pos++;
+            return true;
+        }
+        while ( true ) {
+            arrayValue.push_back(JsonValue());
+            if ( !arrayValue.back().parseValue(text, pos, error) ) {
+                return false;
+            }
+            skipSpaces(text, pos);
+            if ( pos < text.size() && text[pos] == ',' ) {
+                pos++;
+            } else if ( pos < text.size() && text[pos] == ']' ) {
+                pos++;
+                return true;
+            } else {
+                error = "expected ',' or ']' at offset " + std::to_string(pos);
+                return false;
+            }
+        }
+    } else if ( c == '"' ) {
+        type = JSON_STRING;
+        return parseString(text, pos, stringValue, error);
+    } else if ( parseLiteral(text, pos, "true") ) {
+        type = JSON_BOOL;
+        boolValue = true;
+        return true;
+    } else if ( parseLiteral(text, pos, "false") ) {
+        type = JSON_BOOL;
+        boolValue = false;
+        return true;
+    } else if ( parseLiteral(text, pos, "null") ) {
+        type = JSON_NULL;
+        return true;
+    }
+
+    const char *begin = text.c_str() + pos;
+    char *end;
+    numberValue = std::strtod(begin, &end);
+    if ( end == begin ) {
+        error = "unexpected character at offset " + std::to_string(pos);
+        return false;
+    }
+    type = JSON_NUMBER;
+    pos += end - begin;
+    return true;
+}
+
+JsonValue::jsonType JsonValue::getType() const {
+    return type;
+}
+
+bool JsonValue::isObject() const {
+    return type == JSON_OBJECT;
+}
+
+bool JsonValue::isArray() const {
+    return type == JSON_ARRAY;
+}
+
+bool JsonValue::isNumber() const {
+    return type == JSON_NUMBER;
+}
+
+bool JsonValue::isString() const {
+    return type == JSON_STRING;
+}
+
+bool JsonValue::isBool() const {
+    return type == JSON_BOOL;
+}
+
+double JsonValue::getNumber() const {
+    return numberValue;
+}
+
+const std::string &JsonValue::getString() const {
+    return stringValue;
+}
+
+bool JsonValue::getBool() const {
+    return boolValue;
+}
+
+unsigned int JsonValue::size() const {
+    return arrayValue.size();
+}
+
+const JsonValue &JsonValue::operator[](unsigned int index) const {
+    return arrayValue[index];
+}
+
+bool JsonValue::has(const std::string &key) const {
+    return objectValue.count(key) != 0;
+}
+
+const JsonValue &JsonValue::operator[](const std::string &key) const {
+    return objectValue.at(key);
+}
+
+const std::map<std::string, JsonValue> &JsonValue::getMembers() const {
+    return objectValue;
+}
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Multicore.hpp"
+
+Multicore::Multicore(const CacheModel &model, bool compatIndexing, bool mesi)
+    : sharedLevel(model.getLevel(model.getNumLevels() - 1), compatIndexing) {
+    this->compatIndexing = compatIndexing;
+    this->mesi = mesi;
+    numLevels = model.getNumLevels();
+
+    unsigned int granuleBytes = 1;
+    for ( unsigned int level = 0; level + 1 < numLevels; level++ ) {
+        privateConfigs.push_back(model.getLevel(level));
+        if ( model.getLevel(level).lineBytes() > granuleBytes ) {
+            granuleBytes = model.getLevel(level).lineBytes();
+        }
+    }
+    granuleBits = 0;
+    while ( (1U << granuleBits) < granuleBytes ) {
+        granuleBits++;
+    }
+
+    stats = std::vector<LevelStats>(numLevels, LevelStats());
+    coherenceStats = CoherenceStats();
+    memReadBytes = 0;
+    memWriteBytes = 0;
+}
+
+// Cores are created when their TID first shows up. Beyond MAX_CORES, TIDs share cores
+unsigned int Multicore::getCore(unsigned int tid) {
+    std::unordered_map<unsigned int, unsigned int>::iterator it = tidCores.find(tid);
+    if ( it != tidCores.end() ) {
+        return it->second;
+    }
+    unsigned int core = tidCores.size() % MAX_CORES;
+    tidCores[tid] = core;
+    if ( core == cores.size() ) {
+        std::unique_ptr<Core> newCore(new Core());
+        newCore->tid = tid;
+        for ( unsigned int level = 0; level < privateConfigs.size(); level++ ) {
+            newCore->levels.push_back(Cache(privateConfigs[level], compatIndexing));
+        }
+        cores.push_back(std::move(newCore));
+    }
+    return core;
+}
+
+/*
+ * Same write-back/write-through handling as the single core hierarchy
+ */
+void Multicore::fillLine(unsigned int core, unsigned int level, unsigned long line, unsigned long set, bool isDirty) {
+    Cache &cache = getCache(core, level);
+    unsigned long victim;
+    bool victimDirty;
+    cache.fill(line, set, isDirty, victim, victimDirty);
+    if ( victim != Cache::INVALID_LINE && victimDirty ) {
+        stats[level].writebacks++;
+        writeLine(core, level + 1, cache.getAddress(victim), cache.getConfig().lineBytes());
+    }
+}
+
+void Multicore::writeLine(unsigned int core, unsigned int level, unsigned long address, unsigned int bytes) {
+    if ( level == numLevels ) {
+        memWriteBytes += bytes;
+        return;
+    }
+    Cache &cache = getCache(core, level);
+    const CacheConfig &config = cache.getConfig();
+    unsigned long line = cache.getLine(address);
+    unsigned long set = cache.getSet(line);
+    int way = cache.find(line, set);
+    if ( way >= 0 ) {
+        cache.touch(set, way);
+        if ( config.writeBack ) {
+            cache.setDirty(set, way);
+            return;
+        }
+    } else if ( config.writeAllocate ) {
+        fillLine(core, level, line, set, config.writeBack);
+        if ( config.writeBack ) {
+            return;
+        }
+    }
+    stats[level].writebacks++;
+    writeLine(core, level + 1, address, bytes);
+}
+
+/*
+ * Coherence
+ */
+bool Multicore::hasGranule(unsigned int core, unsigned long granule) {
+    for ( unsigned int level = 0; level + 1 < numLevels; level++ ) {
+        Cache &cache = getCache(core, level);
+        unsigned int lineBytes = cache.getConfig().lineBytes();
+        for ( unsigned long address = granule << granuleBits; address < (granule + 1) << granuleBits; address += lineBytes ) {
+            unsigned long line = cache.getLine(address);
+            if ( cache.find(line, cache.getSet(line)) >= 0 ) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Invalidates (or downgrades) the private copies of a granule, writing modified data
+// back to the shared level. Returns whether the core had a copy
+bool Multicore::removeGranule(unsigned int core, unsigned long granule, bool invalidate) {
+    bool found = false;
+    bool modified = false;
+    for ( unsigned int level = 0; level + 1 < numLevels; level++ ) {
+        Cache &cache = getCache(core, level);
+        unsigned int lineBytes = cache.getConfig().lineBytes();
+        for ( unsigned long address = granule << granuleBits; address < (granule + 1) << granuleBits; address += lineBytes ) {
+            unsigned long line = cache.getLine(address);
+            unsigned long set = cache.getSet(line);
+            int way = cache.find(line, set);
+            if ( way < 0 ) {
+                continue;
+            }
+            found = true;
+            modified |= cache.isDirty(set, way);
+            if ( invalidate ) {
+                cache.invalidate(set, way);
+            } else {
+                cache.clearDirty(set, way);
+            }
+        }
+    }
+
+    if ( modified ) {
+        coherenceStats.coherenceWritebacks++;
+        unsigned int lineBytes = sharedLevel.getConfig().lineBytes();
+        for ( unsigned long address = granule << granuleBits; address < (granule + 1) << granuleBits; address += lineBytes ) {
+            writeLine(core, numLevels - 1, address, lineBytes);
+        }
+    }
+    return found;
+}
+
+void Multicore::invalidateSharers(unsigned int core, unsigned long granule, DirectoryEntry &entry) {
+    for ( unsigned int other = 0; other < cores.size(); other++ ) {
+        if ( other == core || (entry.sharers & (1UL << other)) == 0 ) {
+            continue;
+        }
+        if ( removeGranule(other, granule, true) ) {
+            coherenceStats.invalidations++;
+            cores[other]->lostGranules.insert(granule);
+        }
+    }
+    entry.sharers = 1UL << core;
+    entry.owner = core;
+}
+
+void Multicore::readShared(unsigned int core, unsigned long granule) {
+    DirectoryEntry &entry = directory.emplace(granule, DirectoryEntry{ 0, -1 }).first->second;
+    if ( entry.owner >= 0 && entry.owner != (int) core ) {
+        removeGranule(entry.owner, granule, false);
+    }
+    // Forget the cores that silently evicted their copies
+    for ( unsigned int other = 0; other < cores.size(); other++ ) {
+        if ( other != core && (entry.sharers & (1UL << other)) != 0 && !hasGranule(other, granule) ) {
+            entry.sharers &= ~(1UL << other);
+        }
+    }
+    entry.sharers |= 1UL << core;
+    entry.owner = (mesi && entry.sharers == (1UL << core)) ? (int) core : -1;
+}
+
+void Multicore::takeOwnership(unsigned int core, unsigned long granule, bool isUpgrade) {
+    DirectoryEntry &entry = directory.emplace(granule, DirectoryEntry{ 0, -1 }).first->second;
+    if ( entry.owner == (int) core ) {
+        // Already modified, or exclusive (MESI)
+        return;
+    }
+    if ( isUpgrade ) {
+        coherenceStats.upgrades++;
+    }
+    invalidateSharers(core, granule, entry);
+}
+
+unsigned int Multicore::access(unsigned int tid, unsigned long address, bool isWrite, unsigned int bytes) {
+    unsigned int core = getCore(tid);
+    unsigned long granule = address >> granuleBits;
+    bool wantsOwnership = isWrite;
+
+    for ( unsigned int level = 0; level < numLevels; level++ ) {
+        bool shared = (level + 1 == numLevels);
+        if ( shared ) {
+            // Missed all the private levels
+            Core &thisCore = *cores[core];
+            if ( thisCore.lostGranules.erase(granule) > 0 ) {
+                coherenceStats.coherenceMisses++;
+            }
+            if ( wantsOwnership ) {
+                takeOwnership(core, granule, false);
+            } else {
+                readShared(core, granule);
+            }
+        }
+
+        Cache &cache = getCache(core, level);
+        const CacheConfig &config = cache.getConfig();
+        unsigned long line = cache.getLine(address);
+        unsigned long set = cache.getSet(line);
+        int way = cache.find(line, set);
+
+        stats[level].accesses++;
+        if ( isWrite ) {
+            stats[level].writeAccesses++;
+        }
+        if ( way >= 0 ) {
+            cache.touch(set, way);
+            stats[level].hits++;
+            // A store that allocated in an upper level still needs to own the line
+            if ( wantsOwnership && !shared ) {
+                takeOwnership(core, granule, true);
+            }
+            if ( isWrite ) {
+                stats[level].writeHits++;
+                if ( config.writeBack ) {
+                    cache.setDirty(set, way);
+                } else {
+                    stats[level].writebacks++;
+                    writeLine(core, level + 1, address, bytes);
+                }
+            }
+            return level;
+        }
+        stats[level].evicts++;
+
+        if ( !isWrite ) {
+            fillLine(core, level, line, set, false);
+        } else if ( config.writeAllocate ) {
+            fillLine(core, level, line, set, config.writeBack);
+            isWrite = !config.writeBack;
+        }
+        if ( isWrite ) {
+            stats[level].writebacks++;
+        }
+    }
+
+    if ( isWrite ) {
+        memWriteBytes += bytes;
+    } else {
+        memReadBytes += sharedLevel.getConfig().lineBytes();
+    }
+    return numLevels;
+}
+
+void Multicore::resetStats() {
+    stats = std::vector<LevelStats>(stats.size(), LevelStats());
+    coherenceStats = CoherenceStats();
+    memReadBytes = 0;
+    memWriteBytes = 0;
+}
@@ -0,0 +1,379 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Options.hpp"
+#include "Prefetcher.hpp"
+
+#include <cstdlib>
+
+/*
+ * Private functions
+ */
+void printUsage() {
+    std::cout << "sve-cachesim [OPTIONS] memtrace_file cache_model.json" << std::endl;
+    exit(1);
+}
+
+// Reads "min:max", both powers of two
+void readRange(const char *arg, const char *name, unsigned long &min, unsigned long &max) {
+    char *end;
+    min = strtoul(arg, &end, 0);
+    if ( *end == ':' ) {
+        max = strtoul(end + 1, &end, 0);
+    } else {
+        max = min;
+    }
+    if ( *end != '\0' || min == 0 || max < min || (min & (min - 1)) != 0 || (max & (max - 1)) != 0 ) {
+        std::cout << "The " << name << " range must be min:max, with powers of two! Exiting..." << std::endl;
+        exit(1);
+    }
+}
+
+void printHelp() {
+    std::cout << "sve-cachesim [OPTIONS] memtrace_file cache_model.json" << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "\t-c               Index sets like sve-cachesim.py does (line address modulo number of sets)" << std::endl;
+    std::cout << "\t-g               Coalesce gathers/scatters: one request per distinct line of a bundle, split accesses at line boundaries" << std::endl;
+    std::cout << "\t-T               Overlap independent misses, limited by the MSHRs of every level and the window of the model" << std::endl;
+    std::cout << "\t-s [h]<ratio>    Approximate: simulate one in <ratio> sets (a power of two), hashed subset with h" << std::endl;
+    std::cout << "\t-w [@]<records>  Warm the caches up with the first <records>, or those before sequence number <records> with @" << std::endl;
+    std::cout << "\t-x <snapshot>    Save the cache contents to <snapshot> after the warmup" << std::endl;
+    std::cout << "\t-i <snapshot>    Load the cache contents from <snapshot>, the warmup records are skipped" << std::endl;
+    std::cout << "\t-P <count>       Print the <count> PCs with most cycles, with their accesses, hits per level and misses" << std::endl;
+    std::cout << "\t-b <chunks>      Number of parsed chunks buffered ahead of the simulation (default: 4)" << std::endl;
+    std::cout << "\t-t <threads>     Number of threads simulating different sets (default: 1)" << std::endl;
+    std::cout << "\t-m <protocol>    Multicore: private levels per TID, shared last level, msi or mesi coherence" << std::endl;
+    std::cout << "\t-p <prefetcher>  Prefetch into the fetch level of the model: prefetch_commonStride, stride, nextline or stream" << std::endl;
+    std::cout << "\t-W <level>       Sweep the sizes and associativities of <level> (LRU, loads only) and print them as CSV" << std::endl;
+    std::cout << "\t-S <min:max>     Cache sizes of the sweep, in bytes (default: the size of the level)" << std::endl;
+    std::cout << "\t-A <min:max>     Associativities of the sweep (default: the associativity of the level)" << std::endl;
+    std::cout << "\t-o <outputFile>  Write the report to <outputFile> as well (default: stdout only)" << std::endl;
+#ifdef ENABLE_GZIP
+    std::cout << "\t-z               Memory trace is zipped (default: no zip)" << std::endl;
+#endif
+    std::cout << "\t-h               Print this help" << std::endl;
+    std::cout << "Use - as memtrace_file to read the memory trace from the standard input" << std::endl;
+    exit(0);
+}
+
+/*
+ * Public functions
+ */
+Options::Options() {
+    outputFile = std::string();
+    traceFile = std::string();
+    modelFile = std::string();
+    prefetcher = std::string();
+    coherenceProtocol = std::string();
+    sweepLevel = 0;
+    minSweepSize = 0;
+    maxSweepSize = 0;
+    minSweepWays = 0;
+    maxSweepWays = 0;
+    compatIndexing = false;
+    coalescing = false;
+    timing = false;
+    sampleRatio = 1;
+    hashedSampling = false;
+    warmupRecords = 0;
+    warmupSeqNumber = 0;
+    saveSnapshotFile = std::string();
+    loadSnapshotFile = std::string();
+    topPcs = 0;
+    bufferedChunks = 4;
+    concurrentThreads = 1;
+#ifdef ENABLE_GZIP
+    zipped = false;
+#endif
+}
+
+void Options::readOptions(int argc, char *argv[]) {
+    int c;
+    int fileFounds = 0;
+    int optind2 = 1;
+    while ( optind2 < argc ) {
+#ifdef ENABLE_GZIP
+        if (( c = getopt(argc, argv, "cgTs:w:x:i:P:b:t:m:p:W:S:A:o:zh")) != -1 ) {
+#else
+        if (( c = getopt(argc, argv, "cgTs:w:x:i:P:b:t:m:p:W:S:A:o:h")) != -1 ) {
+#endif
+            switch(c) {
+                case 'o':
+                    optind2++;
+                    this->outputFile = std::string(argv[optind2]);
+                    optind2++;
+                    break;
+#ifdef ENABLE_GZIP
+                case 'z':
+                    this->zipped = true;
+                    optind2++;
+                    break;
+#endif
+                case 'b':
+                    optind2++;
+                    this->bufferedChunks = atoi(argv[optind2]);
+                    if ( this->bufferedChunks == 0 ) {
+                        std::cout << "At least one chunk must be buffered! Exiting..." << std::endl;
+                        exit(1);
+                    }
+                    optind2++;
+                    break;
+                case 't':
+                    optind2++;
+                    this->concurrentThreads = atoi(argv[optind2]);
+                    if ( this->concurrentThreads == 0 ) {
+                        std::cout << "At least one thread is needed! Exiting..." << std::endl;
+                        exit(1);
+                    }
+                    optind2++;
+                    break;
+                case 'm':
+                    optind2++;
+                    this->coherenceProtocol = std::string(argv[optind2]);
+                    if ( this->coherenceProtocol != "msi" && this->coherenceProtocol != "mesi" ) {
+                        std::cout << "The coherence protocol must be msi or mesi! Exiting..." << std::endl;
+                        exit(1);
+                    }
+                    optind2++;
+                    break;
+                case 'p':
+                    optind2++;
+                    this->prefetcher = std::string(argv[optind2]);
+                    if ( !Prefetcher::isValid(this->prefetcher) ) {
+                        std::cout << "Unknown prefetcher, use one of " << Prefetcher::getNames() << ". Exiting..." << std::endl;
+                        exit(1);
+                    }
+                    optind2++;
+                    break;
+                case 'W':
+                    optind2++;
+                    this->sweepLevel = atoi(argv[optind2]);
+                    if ( this->sweepLevel == 0 ) {
+                        std::cout << "Levels are numbered from 1! Exiting..." << std::endl;
+                        exit(1);
+                    }
+                    optind2++;
+                    break;
+                case 'S':
+                    optind2++;
+                    readRange(argv[optind2], "cache size", this->minSweepSize, this->maxSweepSize);
+                    optind2++;
+                    break;
+                case 'A':
+                    optind2++;
+                    readRange(argv[optind2], "associativity", this->minSweepWays, this->maxSweepWays);
+                    optind2++;
+                    break;
+                case 'c':
+                    this->compatIndexing = true;
+                    optind2++;
+                    break;
+                case 'g':
+                    this->coalescing = true;
+                    optind2++;
+                    break;
+                case 'T':
+                    this->timing = true;
+                    optind2++;
+                    break;
+                case 's': {
+                    optind2++;
+                    const char *ratio = argv[optind2];
+                    if ( *ratio == 'h' ) {
+                        this->hashedSampling = true;
+                        ratio++;
+                    }
+                    this->sampleRatio = atoi(ratio);
+                    if ( this->sampleRatio < 2 || this->sampleRatio > 4096 || (this->sampleRatio & (this->sampleRatio - 1)) != 0 ) {
+                        std::cout << "The sampling ratio must be a power of two, from 2 to 4096! Exiting..." << std::endl;
+                        exit(1);
+                    }
+                    optind2++;
+                    break;
+                }
+                case 'w': {
+                    optind2++;
+                    const char *warmup = argv[optind2];
+                    char *end;
+                    unsigned long value = strtoul(warmup + (*warmup == '@'), &end, 0);
+                    if ( *end != '\0' || value == 0 ) {
+                        std::cout << "The warmup must be a number of records, or @ and a sequence number! Exiting..." << std::endl;
+                        exit(1);
+                    }
+                    if ( *warmup == '@' ) {
+                        this->warmupSeqNumber = value;
+                    } else {
+                        this->warmupRecords = value;
+                    }
+                    optind2++;
+                    break;
+                }
+                case 'x':
+                    optind2++;
+                    this->saveSnapshotFile = std::string(argv[optind2]);
+                    optind2++;
+                    break;
+                case 'i':
+                    optind2++;
+                    this->loadSnapshotFile = std::string(argv[optind2]);
+                    if ( access(this->loadSnapshotFile.c_str(), F_OK) == -1 ) {
+                        std::cout << "Snapshot file not found! Exiting..." << std::endl;
+                        exit(1);
+                    }
+                    optind2++;
+                    break;
+                case 'P':
+                    optind2++;
+                    this->topPcs = atoi(argv[optind2]);
+                    if ( this->topPcs == 0 ) {
+                        std::cout << "At least one PC must be printed! Exiting..." << std::endl;
+                        exit(1);
+                    }
+                    optind2++;
+                    break;
+                case 'h':
+                    printHelp();
+                    break;
+                default:
+                    printUsage();
+                    break;
+            }
+        } else {
+            if ( fileFounds == 0 ) {
+                this->traceFile = std::string(argv[optind2]);
+                if ( this->traceFile != "-" && access(this->traceFile.c_str(), F_OK) == -1 ) {
+                    std::cout << "Memory trace file not found! Exiting..." << std::endl;
+                    exit(1);
+                }
+            } else if ( fileFounds == 1 ) {
+                this->modelFile = std::string(argv[optind2]);
+                if ( access(this->modelFile.c_str(), F_OK) == -1 ) {
+                    std::cout << "Cache model file not found! Exiting..." << std::endl;
+                    exit(1);
+                }
+            }
+            fileFounds++;
+            optind2++;
+        }
+    }
+    if ( fileFounds != 2 ) {
+        printUsage();
+    }
+    if ( !this->saveSnapshotFile.empty() && this->warmupRecords == 0 && this->warmupSeqNumber == 0 ) {
+        std::cout << "-x saves the caches after the warmup, which needs -w! Exiting..." << std::endl;
+        exit(1);
+    }
+    if ( this->sweepLevel == 0 && (this->minSweepSize != 0 || this->minSweepWays != 0) ) {
+        std::cout << "-S and -A need the level to sweep (-W)! Exiting..." << std::endl;
+        exit(1);
+    }
+}
+
+std::string Options::getTraceFile() {
+    return traceFile;
+}
+
+std::string Options::getModelFile() {
+    return modelFile;
+}
+
+std::string Options::getOutFile() {
+    return outputFile;
+}
+
+std::string Options::getPrefetcher() {
+    return prefetcher;
+}
+
+std::string Options::getCoherenceProtocol() {
+    return coherenceProtocol;
+}
+
+unsigned int Options::getSweepLevel() {
+    return sweepLevel;
+}
+
+unsigned long Options::getMinSweepSize() {
+    return minSweepSize;
+}
+
+unsigned long Options::getMaxSweepSize() {
+    return maxSweepSize;
+}
+
+unsigned int Options::getMinSweepWays() {
+    return minSweepWays;
+}
+
+unsigned int Options::getMaxSweepWays() {
+    return maxSweepWays;
+}
+
+bool Options::isCompatIndexing() {
+    return compatIndexing;
+}
+
+bool Options::isCoalescing() {
+    return coalescing;
+}
+
+bool Options::isTiming() {
+    return timing;
+}
+
+unsigned int Options::getSampleRatio() {
+    return sampleRatio;
+}
+
+bool Options::isHashedSampling() {
+    return hashedSampling;
+}
+
+unsigned long Options::getWarmupRecords() {
+    return warmupRecords;
+}
+
+unsigned long Options::getWarmupSeqNumber() {
+    return warmupSeqNumber;
+}
+
+std::string Options::getSaveSnapshotFile() {
+    return saveSnapshotFile;
+}
+
+std::string Options::getLoadSnapshotFile() {
+    return loadSnapshotFile;
+}
+
+unsigned int Options::getTopPcs() {
+    return topPcs;
+}
+
+unsigned int Options::getBufferedChunks() {
+    return bufferedChunks;
+}
+
+unsigned int Options::getConcurrentThreads() {
+    return concurrentThreads;
+}
+
+#ifdef ENABLE_GZIP
+bool Options::isZipped() {
+    return zipped;
+}
+#endif
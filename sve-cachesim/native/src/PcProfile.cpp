@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "PcProfile.hpp"
+
+#include <algorithm>
+#include <iomanip>
+
+PcProfile::PcProfile(unsigned int numLevels) {
+    this->numLevels = numLevels;
+}
+
+void PcProfile::printReport(std::ostream &os, unsigned int top, double scale) const {
+    std::vector<std::pair<unsigned long, unsigned long>> order;
+    unsigned long totalCycles = 0;
+    for ( auto it = pcs.begin(); it != pcs.end(); ++it ) {
+        order.push_back(std::make_pair(it->second.cycles, it->first));
+        totalCycles += it->second.cycles;
+    }
+    // Most cycles first, lowest PC first on ties so that the output is stable
+    std::sort(order.begin(), order.end(), [](const std::pair<unsigned long, unsigned long> &a,
+        const std::pair<unsigned long, unsigned long> &b) {
+        return a.first != b.first ? a.first > b.first : a.second < b.second;
+    });
+
+    os << "PC\t\tAccesses";
+    for ( unsigned int level = 0; level < numLevels; level++ ) {
+        os << "\tl" << level + 1 << " Hits";
+    }
+    os << "\tMisses\tCycles\tCycles Share" << std::endl;
+    for ( unsigned int i = 0; i < order.size() && i < top; i++ ) {
+        const PcStats &stats = pcs.at(order[i].second);
+        os << "0x" << std::hex << order[i].second << std::dec;
+        os << "\t" << (unsigned long) (stats.accesses * scale + 0.5);
+        for ( unsigned int level = 0; level < numLevels; level++ ) {
+            os << "\t" << (unsigned long) (stats.hits[level] * scale + 0.5);
+        }
+        os << "\t" << (unsigned long) (stats.misses * scale + 0.5);
+        os << "\t" << (unsigned long) (stats.cycles * scale + 0.5);
+        os << "\t" << std::fixed << std::setprecision(2) << (totalCycles ? (double) stats.cycles / totalCycles * 100 : 0.0) << "%" << std::endl;
+    }
+}
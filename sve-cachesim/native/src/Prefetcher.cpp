@@ -0,0 +1,213 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Prefetcher.hpp"
+
+/*
+ * Public functions
+ */
+Prefetcher::Prefetcher(unsigned int degree, unsigned int distance, unsigned int lineBytes) {
+    this->degree = degree;
+    this->distance = distance;
+    lineBits = 0;
+    while ( (1U << lineBits) < lineBytes ) {
+        lineBits++;
+    }
+}
+
+bool Prefetcher::isValid(const std::string &name) {
+    return name == "prefetch_commonStride" || name == "stride" || name == "nextline" || name == "stream";
+}
+
+std::string Prefetcher::getNames() {
+    return "prefetch_commonStride, stride, nextline, stream";
+}
+
+Prefetcher *Prefetcher::create(const std::string &name, unsigned int degree, unsigned int distance, unsigned int lineBytes) {
+    if ( name == "stride" ) {
+        return new StridePrefetcher(degree, distance, lineBytes);
+    } else if ( name == "nextline" ) {
+        return new NextLinePrefetcher(degree, distance, lineBytes);
+    } else if ( name == "stream" ) {
+        return new StreamPrefetcher(degree, distance, lineBytes);
+    }
+    return new CommonStridePrefetcher(degree, distance, lineBytes);
+}
+
+CommonStridePrefetcher::CommonStridePrefetcher(unsigned int degree, unsigned int distance, unsigned int lineBytes)
+    : Prefetcher(degree, distance, lineBytes) {
+    history = std::vector<unsigned long>(HISTORY);
+    historyStart = 0;
+    historySize = 0;
+    countFrequency = std::vector<unsigned int>(HISTORY + 1, 0);
+    maxCount = 0;
+}
+
+void CommonStridePrefetcher::addStride(long stride) {
+    unsigned int &count = strideCounts[stride];
+    if ( count > 0 ) {
+        countFrequency[count]--;
+    }
+    count++;
+    countFrequency[count]++;
+    if ( count > maxCount ) {
+        maxCount = count;
+    }
+}
+
+void CommonStridePrefetcher::removeStride(long stride) {
+    std::unordered_map<long, unsigned int>::iterator it = strideCounts.find(stride);
+    countFrequency[it->second]--;
+    if ( it->second == maxCount && countFrequency[it->second] == 0 ) {
+        maxCount--;
+    }
+    it->second--;
+    if ( it->second == 0 ) {
+        strideCounts.erase(it);
+    } else {
+        countFrequency[it->second]++;
+    }
+}
+
+void CommonStridePrefetcher::observe(unsigned long address, unsigned long pc, bool miss, std::vector<unsigned long> &prefetches) {
+    // Forget the oldest address and its stride
+    if ( historySize == HISTORY ) {
+        long stride = history[(historyStart + 1) % HISTORY] - history[historyStart];
+        if ( stride != 0 ) {
+            removeStride(stride);
+        }
+        historyStart = (historyStart + 1) % HISTORY;
+        historySize--;
+    }
+    if ( historySize > 0 ) {
+        long stride = address - history[(historyStart + historySize - 1) % HISTORY];
+        if ( stride != 0 ) {
+            addStride(stride);
+        }
+    }
+    history[(historyStart + historySize) % HISTORY] = address;
+    historySize++;
+
+    if ( maxCount == 0 ) {
+        prefetches.push_back(address);
+        return;
+    }
+    for ( unsigned int i = 0; i < degree; i++ ) {
+        prefetches.push_back(address + (unsigned long) maxCount * (distance + i));
+    }
+}
+
+StridePrefetcher::StridePrefetcher(unsigned int degree, unsigned int distance, unsigned int lineBytes)
+    : Prefetcher(degree, distance, lineBytes) {
+    Entry empty = { ~0UL, 0, 0, 0 };
+    table = std::vector<Entry>(TABLE_ENTRIES, empty);
+}
+
+void StridePrefetcher::observe(unsigned long address, unsigned long pc, bool miss, std::vector<unsigned long> &prefetches) {
+    Entry &entry = table[(pc >> 2) % TABLE_ENTRIES];
+    if ( entry.pc != pc ) {
+        entry.pc = pc;
+        entry.lastAddress = address;
+        entry.stride = 0;
+        entry.confidence = 0;
+        return;
+    }
+
+    long stride = address - entry.lastAddress;
+    if ( stride == entry.stride ) {
+        if ( entry.confidence < MAX_CONFIDENCE ) {
+            entry.confidence++;
+        }
+    } else {
+        entry.stride = stride;
+        entry.confidence = 0;
+    }
+    entry.lastAddress = address;
+
+    if ( entry.confidence < MIN_CONFIDENCE || entry.stride == 0 ) {
+        return;
+    }
+    // Small strides would prefetch the same line several times
+    unsigned long lastLine = address >> lineBits;
+    for ( unsigned int i = 0; i < degree; i++ ) {
+        unsigned long target = address + entry.stride * (long) (distance + i);
+        if ( (target >> lineBits) != lastLine ) {
+            prefetches.push_back(target);
+            lastLine = target >> lineBits;
+        }
+    }
+}
+
+NextLinePrefetcher::NextLinePrefetcher(unsigned int degree, unsigned int distance, unsigned int lineBytes)
+    : Prefetcher(degree, distance, lineBytes) {
+}
+
+void NextLinePrefetcher::observe(unsigned long address, unsigned long pc, bool miss, std::vector<unsigned long> &prefetches) {
+    if ( !miss ) {
+        return;
+    }
+    unsigned long line = address >> lineBits;
+    for ( unsigned int i = 0; i < degree; i++ ) {
+        prefetches.push_back((line + distance + i) << lineBits);
+    }
+}
+
+StreamPrefetcher::StreamPrefetcher(unsigned int degree, unsigned int distance, unsigned int lineBytes)
+    : Prefetcher(degree, distance, lineBytes) {
+    Stream empty = { 0, 0, 0, false };
+    streams = std::vector<Stream>(STREAMS, empty);
+    misses = 0;
+}
+
+void StreamPrefetcher::observe(unsigned long address, unsigned long pc, bool miss, std::vector<unsigned long> &prefetches) {
+    if ( !miss ) {
+        return;
+    }
+    misses++;
+    long line = address >> lineBits;
+
+    // Look for the stream this miss belongs to, or the least recently used one to replace
+    unsigned int victim = 0;
+    for ( unsigned int i = 0; i < STREAMS; i++ ) {
+        Stream &stream = streams[i];
+        if ( stream.valid && line - stream.lastLine <= WINDOW && stream.lastLine - line <= WINDOW ) {
+            stream.lastUse = misses;
+            if ( line == stream.lastLine ) {
+                return;
+            }
+            int direction = (line > stream.lastLine) ? 1 : -1;
+            bool confirmed = (direction == stream.direction);
+            stream.direction = direction;
+            stream.lastLine = line;
+            if ( confirmed ) {
+                for ( unsigned int j = 0; j < degree; j++ ) {
+                    prefetches.push_back((line + direction * (long) (distance + j)) << lineBits);
+                }
+            }
+            return;
+        }
+        if ( !stream.valid || (streams[victim].valid && stream.lastUse < streams[victim].lastUse) ) {
+            victim = i;
+        }
+    }
+
+    streams[victim].lastLine = line;
+    streams[victim].direction = 0;
+    streams[victim].lastUse = misses;
+    streams[victim].valid = true;
+}
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ReplacementPolicy.hpp"
+#include "Utils.hpp"
+
+/*
+ * Private functions
+ */
+uint32_t seedRandom(unsigned long set) {
+    uint32_t seed = (uint32_t) ((set + 1) * 2654435761UL);
+    return seed == 0 ? 1 : seed;
+}
+
+// xorshift32
+uint32_t nextRandom(uint32_t &state) {
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+/*
+ * Public functions
+ */
+bool ReplacementPolicy::isValid(const std::string &name) {
+    return name == "fifo" || name == "lru" || name == "plru" || name == "srrip" || name == "brrip" || name == "random";
+}
+
+unsigned int ReplacementPolicy::getMaxWays(const std::string &name) {
+    if ( name == "plru" || name == "srrip" || name == "brrip" ) {
+        return 64;
+    }
+    if ( name == "lru" ) {
+        return 65535;
+    }
+    return ~0U;
+}
+
+ReplacementPolicy *ReplacementPolicy::create(const std::string &name, unsigned long numSets, unsigned int ways) {
+    if ( name == "lru" ) {
+        return new LruPolicy(numSets, ways);
+    } else if ( name == "plru" ) {
+        return new PlruPolicy(numSets, ways);
+    } else if ( name == "srrip" ) {
+        return new RripPolicy(numSets, ways, false);
+    } else if ( name == "brrip" ) {
+        return new RripPolicy(numSets, ways, true);
+    } else if ( name == "random" ) {
+        return new RandomPolicy(numSets, ways);
+    }
+    return new FifoPolicy(numSets, ways);
+}
+
+FifoPolicy::FifoPolicy(unsigned long numSets, unsigned int ways) : ReplacementPolicy(numSets, ways) {
+    nextVictim = std::vector<unsigned int>(numSets, 0);
+}
+
+LruPolicy::LruPolicy(unsigned long numSets, unsigned int ways) : ReplacementPolicy(numSets, ways) {
+    prev = std::vector<uint16_t>(numSets * ways);
+    next = std::vector<uint16_t>(numSets * ways);
+    head = std::vector<uint16_t>(numSets, 0);
+    tail = std::vector<uint16_t>(numSets, ways - 1);
+    for ( unsigned long set = 0; set < numSets; set++ ) {
+        for ( unsigned int way = 0; way < ways; way++ ) {
+            prev[set * ways + way] = way == 0 ? 0 : way - 1;
+            next[set * ways + way] = way + 1 == ways ? way : way + 1;
+        }
+    }
+}
+
+void LruPolicy::moveToFront(unsigned long set, unsigned int way) {
+    unsigned int first = head[set];
+    if ( first == way ) {
+        return;
+    }
+    uint16_t *setPrev = &prev[set * ways];
+    uint16_t *setNext = &next[set * ways];
+
+    // Unlink
+    unsigned int before = setPrev[way];
+    setNext[before] = setNext[way];
+    if ( tail[set] == way ) {
+        tail[set] = before;
+    } else {
+        setPrev[setNext[way]] = before;
+    }
+
+    // Link in front of the list
+    setNext[way] = first;
+    setPrev[first] = way;
+    head[set] = way;
+}
+
+PlruPolicy::PlruPolicy(unsigned long numSets, unsigned int ways) : ReplacementPolicy(numSets, ways) {
+    leaves = 1;
+    depth = 0;
+    while ( leaves < ways ) {
+        leaves <<= 1;
+        depth++;
+    }
+    trees = std::vector<uint64_t>(numSets, 0);
+}
+
+void PlruPolicy::touch(unsigned long set, unsigned int way) {
+    uint64_t tree = trees[set];
+    // Make every node on the path point away from this way
+    for ( unsigned int node = way + leaves; node > 1; node >>= 1 ) {
+        unsigned int parent = node >> 1;
+        if ( node & 1 ) {
+            tree &= ~(1UL << parent);
+        } else {
+            tree |= 1UL << parent;
+        }
+    }
+    trees[set] = tree;
+}
+
+unsigned int PlruPolicy::victim(unsigned long set) {
+    uint64_t tree = trees[set];
+    unsigned int node = 1;
+    for ( unsigned int level = 0; level < depth; level++ ) {
+        unsigned int child = 2 * node + ((tree >> node) & 1);
+        // Padding leaves are all on the right, go left if the subtree only has padding
+        if ( (child << (depth - level - 1)) - leaves >= ways ) {
+            child = 2 * node;
+        }
+        node = child;
+    }
+    return node - leaves;
+}
+
+RripPolicy::RripPolicy(unsigned long numSets, unsigned int ways, bool bimodal) : ReplacementPolicy(numSets, ways) {
+    this->bimodal = bimodal;
+    waysMask = (ways == 64) ? ~0UL : (1UL << ways) - 1;
+    // Every way starts at the distant RRPV (3)
+    lowBits = std::vector<uint64_t>(numSets, waysMask);
+    highBits = std::vector<uint64_t>(numSets, waysMask);
+    if ( bimodal ) {
+        randomState = std::vector<uint32_t>(numSets);
+        for ( unsigned long set = 0; set < numSets; set++ ) {
+            randomState[set] = seedRandom(set);
+        }
+    }
+}
+
+void RripPolicy::insert(unsigned long set, unsigned int way) {
+    // Long re-reference interval (2), or distant (3) for most of the BRRIP fills
+    highBits[set] |= 1UL << way;
+    if ( bimodal && nextRandom(randomState[set]) % BIMODAL_THROTTLE != 0 ) {
+        lowBits[set] |= 1UL << way;
+    } else {
+        lowBits[set] &= ~(1UL << way);
+    }
+}
+
+unsigned int RripPolicy::victim(unsigned long set) {
+    uint64_t low = lowBits[set];
+    uint64_t high = highBits[set];
+    // At most three rounds of aging until some way reaches RRPV 3
+    while ( (low & high) == 0 ) {
+        high = (high | low) & waysMask;
+        low = ~low & waysMask;
+    }
+    lowBits[set] = low;
+    highBits[set] = high;
+    return __builtin_ctzl(low & high);
+}
+
+RandomPolicy::RandomPolicy(unsigned long numSets, unsigned int ways) : ReplacementPolicy(numSets, ways) {
+    randomState = std::vector<uint32_t>(numSets);
+    for ( unsigned long set = 0; set < numSets; set++ ) {
+        randomState[set] = seedRandom(set);
+    }
+}
+
+unsigned int RandomPolicy::victim(unsigned long set) {
+    return nextRandom(randomState[set]) % ways;
+}
+
+/*
+ * Snapshots
+ */
+void FifoPolicy::save(std::ostream &os) const {
+    writeVector(os, nextVictim);
+}
+
+bool FifoPolicy::load(std::istream &is) {
+    return readVector(is, nextVictim);
+}
+
+void LruPolicy::save(std::ostream &os) const {
+    writeVector(os, prev);
+    writeVector(os, next);
+    writeVector(os, head);
+    writeVector(os, tail);
+}
+
+bool LruPolicy::load(std::istream &is) {
+    return readVector(is, prev) && readVector(is, next) && readVector(is, head) && readVector(is, tail);
+}
+
+void PlruPolicy::save(std::ostream &os) const {
+    writeVector(os, trees);
+}
+
+bool PlruPolicy::load(std::istream &is) {
+    return readVector(is, trees);
+}
+
+void RripPolicy::save(std::ostream &os) const {
+    writeVector(os, lowBits);
+    writeVector(os, highBits);
+    writeVector(os, randomState);
+}
+
+bool RripPolicy::load(std::istream &is) {
+    return readVector(is, lowBits) && readVector(is, highBits) && readVector(is, randomState);
+}
+
+void RandomPolicy::save(std::ostream &os) const {
+    writeVector(os, randomState);
+}
+
+bool RandomPolicy::load(std::istream &is) {
+    return readVector(is, randomState);
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SetSampler.hpp"
+
+#include <cmath>
+#include <algorithm>
+#include <utility>
+
+SetSampler::SetSampler(const CacheModel &model, unsigned int ratio, bool hashed) {
+    unsigned int groupSize = SAMPLE_GROUP * ratio;
+    groupBits = 0;
+    while ( (1U << groupBits) < groupSize ) {
+        groupBits++;
+    }
+    groupMask = groupSize - 1;
+    keptPerGroup = SAMPLE_GROUP;
+
+    // Positions sorted by the value that selects them, the first ones are kept in that order
+    std::vector<std::pair<unsigned long, unsigned int>> order;
+    for ( unsigned int i = 0; i < groupSize; i++ ) {
+        unsigned long key = hashed ? ((i + 1) * 0x9E3779B97F4A7C15UL) >> 16 : (unsigned long) (i % ratio) * groupSize + i;
+        order.push_back(std::make_pair(key, i));
+    }
+    std::sort(order.begin(), order.end());
+    std::sort(order.begin(), order.begin() + keptPerGroup, [](const std::pair<unsigned long, unsigned int> &a,
+        const std::pair<unsigned long, unsigned int> &b) {
+        return a.second < b.second;
+    });
+    positions = std::vector<int>(groupSize, -1);
+    for ( unsigned int i = 0; i < keptPerGroup; i++ ) {
+        positions[order[i].second] = i;
+    }
+
+    unsigned int maxLineBytes = 0;
+    for ( unsigned int level = 0; level < model.getNumLevels(); level++ ) {
+        if ( model.getLevel(level).lineBytes() > maxLineBytes ) {
+            maxLineBytes = model.getLevel(level).lineBytes();
+        }
+    }
+    lineBits = 0;
+    while ( (1U << lineBits) < maxLineBytes ) {
+        lineBits++;
+    }
+    resetStats();
+}
+
+void SetSampler::resetStats() {
+    accesses = 0;
+    sampledAccesses = 0;
+    clusterAccesses = std::vector<unsigned long>(SAMPLE_CLUSTERS, 0);
+    clusterMisses = std::vector<unsigned long>(SAMPLE_CLUSTERS, 0);
+    clusterCycles = std::vector<unsigned long>(SAMPLE_CLUSTERS, 0);
+}
+
+double SetSampler::getHalfInterval(const std::vector<unsigned long> &values) const {
+    unsigned int clusters = 0;
+    double total = 0;
+    for ( unsigned int i = 0; i < SAMPLE_CLUSTERS; i++ ) {
+        if ( clusterAccesses[i] > 0 ) {
+            clusters++;
+            total += values[i];
+        }
+    }
+    if ( clusters < 2 ) {
+        return 0.0;
+    }
+
+    // Ratio estimator over the clusters, with the finite population correction
+    double ratio = total / sampledAccesses;
+    double meanAccesses = (double) sampledAccesses / clusters;
+    double sum = 0;
+    for ( unsigned int i = 0; i < SAMPLE_CLUSTERS; i++ ) {
+        if ( clusterAccesses[i] > 0 ) {
+            double residual = values[i] - ratio * clusterAccesses[i];
+            sum += residual * residual;
+        }
+    }
+    double fraction = accesses ? (double) sampledAccesses / accesses : 1.0;
+    double variance = (1.0 - fraction) * sum / ((clusters - 1) * clusters * meanAccesses * meanAccesses);
+    return 1.96 * std::sqrt(variance);
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StackSweep.hpp"
+
+#include <iomanip>
+
+StackSweep::StackSweep(unsigned int lineBytes, unsigned long minSize, unsigned long maxSize,
+    unsigned int minWays, unsigned int maxWays, bool compatIndexing) {
+    this->compatIndexing = compatIndexing;
+    lineBits = 0;
+    while ( (1U << lineBits) < lineBytes ) {
+        lineBits++;
+    }
+    accesses = 0;
+
+    for ( unsigned long cacheSize = minSize; cacheSize <= maxSize; cacheSize <<= 1 ) {
+        for ( unsigned int ways = minWays; ways <= maxWays; ways <<= 1 ) {
+            unsigned long numSets = cacheSize / ((unsigned long) ways * lineBytes);
+            if ( numSets == 0 ) {
+                continue;
+            }
+            unsigned int group = 0;
+            while ( group < groups.size() && groups[group].numSets != numSets ) {
+                group++;
+            }
+            if ( group == groups.size() ) {
+                SetGroup newGroup;
+                newGroup.numSets = numSets;
+                newGroup.depth = 0;
+                groups.push_back(newGroup);
+            }
+            if ( ways > groups[group].depth ) {
+                groups[group].depth = ways;
+            }
+            Configuration configuration = { cacheSize, ways, group };
+            configurations.push_back(configuration);
+        }
+    }
+
+    for ( unsigned int i = 0; i < groups.size(); i++ ) {
+        groups[i].stacks = std::vector<unsigned long>(groups[i].numSets * groups[i].depth, INVALID_LINE);
+        groups[i].distances = std::vector<unsigned long>(groups[i].depth + 1, 0);
+    }
+}
+
+void StackSweep::printReport(std::ostream &os) const {
+    os << "cachesize,setsize,sets,accesses,hits,misses,hit_rate" << std::endl;
+    os << std::fixed << std::setprecision(4);
+    for ( unsigned int i = 0; i < configurations.size(); i++ ) {
+        const Configuration &configuration = configurations[i];
+        const SetGroup &group = groups[configuration.group];
+        unsigned long hits = 0;
+        for ( unsigned int distance = 0; distance < configuration.ways; distance++ ) {
+            hits += group.distances[distance];
+        }
+        os << configuration.cacheSize << "," << configuration.ways << "," << group.numSets << ","
+           << accesses << "," << hits << "," << accesses - hits << ","
+           << (accesses ? (double) hits / accesses : 0.0) << std::endl;
+    }
+}
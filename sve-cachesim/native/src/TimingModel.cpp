@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TimingModel.hpp"
+
+#include <algorithm>
+#include <functional>
+
+TimingModel::TimingModel(const CacheModel &model) {
+    for ( unsigned int level = 0; level < model.getNumLevels(); level++ ) {
+        mshrs.push_back(std::vector<unsigned long>(model.getLevel(level).mshrs, 0));
+    }
+    window = std::vector<unsigned long>(model.getWindow(), 0);
+    windowHead = 0;
+    memoryLineBytes = model.getLevel(model.getNumLevels() - 1).lineBytes();
+    nextIssue = 0;
+    endCycle = 0;
+    missBusyCycles = 0;
+    missBusyUntil = 0;
+    missCycles = 0;
+    memoryBytes = 0;
+}
+
+void TimingModel::access(unsigned int level, unsigned int latency) {
+    // In order issue, once the oldest access of the window is done
+    unsigned long start = std::max(nextIssue, window[windowHead]);
+    nextIssue = start + 1;
+
+    // Every level that misses needs a free MSHR
+    unsigned int missedLevels = std::min(level, (unsigned int) mshrs.size());
+    for ( unsigned int i = 0; i < missedLevels; i++ ) {
+        start = std::max(start, mshrs[i].front());
+    }
+    unsigned long completion = start + latency;
+    for ( unsigned int i = 0; i < missedLevels; i++ ) {
+        std::vector<unsigned long> &heap = mshrs[i];
+        std::pop_heap(heap.begin(), heap.end(), std::greater<unsigned long>());
+        heap.back() = completion;
+        std::push_heap(heap.begin(), heap.end(), std::greater<unsigned long>());
+    }
+
+    window[windowHead] = completion;
+    windowHead = (windowHead + 1) % window.size();
+    endCycle = std::max(endCycle, completion);
+
+    if ( level == 0 ) {
+        return;
+    }
+    missCycles += latency;
+    // Misses start almost in order, so the union of their intervals is kept as a single end
+    if ( start >= missBusyUntil ) {
+        missBusyCycles += latency;
+    } else if ( completion > missBusyUntil ) {
+        missBusyCycles += completion - missBusyUntil;
+    }
+    missBusyUntil = std::max(missBusyUntil, completion);
+    if ( level == mshrs.size() ) {
+        memoryBytes += memoryLineBytes;
+    }
+}
+
+double TimingModel::getMlp() const {
+    return missBusyCycles ? (double) missCycles / (double) missBusyCycles : 0.0;
+}
+
+double TimingModel::getBandwidth() const {
+    return endCycle ? (double) memoryBytes / (double) endCycle : 0.0;
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Tlb.hpp"
+
+Tlb::Tlb(const CacheModel &model) {
+    for ( unsigned int level = 0; level < model.getNumTlbLevels(); level++ ) {
+        const TlbConfig &tlbConfig = model.getTlbLevel(level);
+        // One page per line, the page numbers index the sets
+        CacheConfig config = CacheConfig();
+        config.level = tlbConfig.level;
+        config.cacheSize = (unsigned long) tlbConfig.entries * tlbConfig.pageSize;
+        config.lineSize = tlbConfig.pageSize;
+        config.setSize = tlbConfig.setSize;
+        config.wordSize = 1;
+        config.latency = tlbConfig.latency;
+        config.replacement = "lru";
+        configs.push_back(tlbConfig);
+        levels.push_back(Cache(config, false));
+    }
+    resetStats();
+}
+
+void Tlb::resetStats() {
+    for ( unsigned int type = 0; type < NUM_ACCESS_CLASSES; type++ ) {
+        stats[type].accesses = 0;
+        stats[type].hits = std::vector<unsigned long>(levels.size(), 0);
+        stats[type].pageWalks = 0;
+        stats[type].cycles = 0;
+    }
+}
+
+const char *Tlb::getClassName(accessClass type) {
+    switch ( type ) {
+        case LOAD_ACCESS:
+            return "Load";
+        case STORE_ACCESS:
+            return "Store";
+        case GATHER_ACCESS:
+            return "Gather";
+        default:
+            return "Scatter";
+    }
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TraceReader.hpp"
+
+#include <string>
+
+TraceReader::TraceReader(std::istream &input, unsigned int bufferedChunks, unsigned int chunkRecords) : input(input) {
+    this->chunkRecords = chunkRecords;
+    slots = std::vector<std::vector<memRecord> >(bufferedChunks);
+    head = 0;
+    tail = 0;
+    fullSlots = 0;
+    finished = false;
+    running = false;
+    pthread_mutex_init(&mutex, NULL);
+    pthread_cond_init(&notEmpty, NULL);
+    pthread_cond_init(&notFull, NULL);
+}
+
+TraceReader::~TraceReader() {
+    if ( running ) {
+        pthread_join(readerThread, NULL);
+    }
+    pthread_cond_destroy(&notFull);
+    pthread_cond_destroy(&notEmpty);
+    pthread_mutex_destroy(&mutex);
+}
+
+void TraceReader::start() {
+    running = true;
+    pthread_create(&readerThread, NULL, readTrace, this);
+}
+
+void *TraceReader::readTrace(void *reader) {
+    TraceReader *self = (TraceReader *) reader;
+    std::vector<memRecord> chunk;
+    chunk.reserve(self->chunkRecords);
+
+    std::string line;
+    memRecord record;
+    while ( std::getline(self->input, line) ) {
+        if ( !parseLine(line, record) ) {
+            continue;
+        }
+        chunk.push_back(record);
+        if ( chunk.size() >= self->chunkRecords ) {
+            self->push(chunk);
+        }
+    }
+    if ( !chunk.empty() ) {
+        self->push(chunk);
+    }
+
+    pthread_mutex_lock(&self->mutex);
+    self->finished = true;
+    pthread_cond_signal(&self->notEmpty);
+    pthread_mutex_unlock(&self->mutex);
+
+    pthread_exit(NULL);
+}
+
+// Waits for a free slot and swaps the chunk into it, getting an empty one back
+void TraceReader::push(std::vector<memRecord> &chunk) {
+    pthread_mutex_lock(&mutex);
+    while ( fullSlots == slots.size() ) {
+        pthread_cond_wait(&notFull, &mutex);
+    }
+    slots[tail].swap(chunk);
+    tail = (tail + 1) % slots.size();
+    fullSlots++;
+    pthread_cond_signal(&notEmpty);
+    pthread_mutex_unlock(&mutex);
+    chunk.clear();
+}
+
+bool TraceReader::next(std::vector<memRecord> &chunk) {
+    pthread_mutex_lock(&mutex);
+    while ( fullSlots == 0 && !finished ) {
+        pthread_cond_wait(&notEmpty, &mutex);
+    }
+    if ( fullSlots == 0 ) {
+        pthread_mutex_unlock(&mutex);
+        return false;
+    }
+    slots[head].swap(chunk);
+    head = (head + 1) % slots.size();
+    fullSlots--;
+    pthread_cond_signal(&notFull);
+    pthread_mutex_unlock(&mutex);
+    return true;
+}
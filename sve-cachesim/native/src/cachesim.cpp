@@ -0,0 +1,573 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Options.hpp"
+#include "Utils.hpp"
+#include "CacheModel.hpp"
+#include "Hierarchy.hpp"
+#include "TraceReader.hpp"
+#include "Prefetcher.hpp"
+#include "StackSweep.hpp"
+#include "Multicore.hpp"
+#include "AccessSplitter.hpp"
+#include "TimingModel.hpp"
+#include "Tlb.hpp"
+#include "SetSampler.hpp"
+#include "PcProfile.hpp"
+
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+#define MIN_CHUNK_SIZE 10000
+// Batches of the set-partitioned simulation, larger to pay for the level by level synchronization
+#define PARALLEL_CHUNK_SIZE 100000
+
+std::string percentage(unsigned long part, unsigned long total) {
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2) << (total ? ((double)part / (double)total) * 100 : 0.0) << "%";
+    return ss.str();
+}
+
+accessClass getAccessClass(const Access &access) {
+    if ( access.isWrite ) {
+        return access.inBundle ? SCATTER_ACCESS : STORE_ACCESS;
+    }
+    return access.inBundle ? GATHER_ACCESS : LOAD_ACCESS;
+}
+
+/*
+ * Stack-distance sweep of one level. The levels above it are simulated as usual
+ * and the accesses that miss all of them go to the sweep
+ */
+int runSweep(Options &opt, const CacheModel &model, Hierarchy &hierarchy, TraceReader &reader) {
+    unsigned int sweepLevel = opt.getSweepLevel() - 1;
+    if ( sweepLevel >= model.getNumLevels() ) {
+        std::cout << "The cache model has no level " << sweepLevel + 1 << ". Exiting..." << std::endl;
+        exit(1);
+    }
+    const CacheConfig &config = model.getLevel(sweepLevel);
+    unsigned long minSize = opt.getMinSweepSize();
+    unsigned long maxSize = opt.getMaxSweepSize();
+    unsigned int minWays = opt.getMinSweepWays();
+    unsigned int maxWays = opt.getMaxSweepWays();
+    if ( minSize == 0 ) {
+        minSize = maxSize = config.cacheSize;
+    }
+    if ( minWays == 0 ) {
+        minWays = maxWays = config.setSize;
+    }
+    if ( (minSize & (minSize - 1)) != 0 || (minWays & (minWays - 1)) != 0 ) {
+        std::cout << "Level " << sweepLevel + 1 << " has a size or associativity that is not a power of two, use -S and -A. Exiting..." << std::endl;
+        exit(1);
+    }
+
+    StackSweep sweep(config.lineBytes(), minSize, maxSize, minWays, maxWays, opt.isCompatIndexing());
+    if ( sweep.getNumConfigurations() == 0 ) {
+        std::cout << "None of the configurations can hold a single set. Exiting..." << std::endl;
+        exit(1);
+    }
+
+    AccessSplitter splitter(model.getLevel(0).lineBytes(), opt.isCoalescing(), false);
+    std::vector<memRecord> chunk;
+    std::vector<Access> accesses;
+    bool more = true;
+    while ( more ) {
+        accesses.clear();
+        more = reader.next(chunk);
+        if ( more ) {
+            splitter.split(chunk, accesses);
+        } else {
+            splitter.finish(accesses);
+        }
+        for ( unsigned int i = 0; i < accesses.size(); i++ ) {
+            if ( hierarchy.access(accesses[i].address) >= sweepLevel ) {
+                sweep.access(accesses[i].address);
+            }
+        }
+    }
+
+    sweep.printReport(std::cout);
+    if ( !opt.getOutFile().empty() ) {
+        std::ofstream outputFile(opt.getOutFile());
+        sweep.printReport(outputFile);
+        outputFile.close();
+    }
+    return 0;
+}
+
+int main (int argc, char *argv[]) {
+    std::ios::sync_with_stdio(false);
+    Options opt;
+    opt.readOptions(argc, argv);
+
+    // The sweep prints plain CSV
+    bool sweeping = opt.getSweepLevel() > 0;
+    if ( !sweeping ) {
+        std::cout << "** Running SVE CacheSim **" << std::endl;
+    }
+
+    CacheModel model;
+    std::string error;
+    if ( !model.load(opt.getModelFile(), error) ) {
+        std::cout << "Wrong cache model: " << error << ". Exiting..." << std::endl;
+        exit(1);
+    }
+
+    // Set sampling simulates a smaller hierarchy with a subset of the lines
+    std::unique_ptr<SetSampler> sampler;
+    if ( opt.getSampleRatio() > 1 ) {
+        if ( !opt.getPrefetcher().empty() || !opt.getCoherenceProtocol().empty() || sweeping || opt.isTiming()
+            || model.getNumTlbLevels() > 0 ) {
+            std::cout << "Set sampling does not support prefetchers, multicore, sweeps, the timing model nor TLBs. Exiting..." << std::endl;
+            exit(1);
+        }
+        if ( !model.sampleSets(opt.getSampleRatio(), error) ) {
+            std::cout << "Cannot sample the cache model: " << error << ". Exiting..." << std::endl;
+            exit(1);
+        }
+        sampler = std::unique_ptr<SetSampler>(new SetSampler(model, opt.getSampleRatio(), opt.isHashedSampling()));
+    }
+
+    Hierarchy hierarchy(model, opt.isCompatIndexing());
+    unsigned int numLevels = hierarchy.getNumLevels();
+
+    std::string prefetcherName = opt.getPrefetcher();
+    std::unique_ptr<Prefetcher> prefetcher;
+    int fetchLevel = model.getFetchLevel();
+    if ( !prefetcherName.empty() ) {
+        if ( fetchLevel < 0 ) {
+            std::cout << "The cache model has no fetch_level for the prefetcher. Exiting..." << std::endl;
+            exit(1);
+        }
+        prefetcher = std::unique_ptr<Prefetcher>(Prefetcher::create(prefetcherName, model.getPrefetchDegree(),
+            model.getPrefetchDistance(), model.getLevel(fetchLevel).lineBytes()));
+    }
+    std::vector<unsigned long> prefetches;
+
+    // Multicore mode, with private levels per TID and a shared last level
+    std::unique_ptr<Multicore> multicore;
+    if ( !opt.getCoherenceProtocol().empty() ) {
+        if ( numLevels < 2 ) {
+            std::cout << "The multicore mode needs at least one private and one shared level. Exiting..." << std::endl;
+            exit(1);
+        }
+        if ( prefetcher || sweeping || model.hasInclusionPolicies() ) {
+            std::cout << "Prefetching, sweeps and inclusion policies are not supported in multicore mode. Exiting..." << std::endl;
+            exit(1);
+        }
+        multicore = std::unique_ptr<Multicore>(new Multicore(model, opt.isCompatIndexing(), opt.getCoherenceProtocol() == "mesi"));
+    }
+
+    std::string traceFileName = opt.getTraceFile();
+    std::ifstream traceFile;
+    if ( traceFileName != "-" ) {
+        traceFile.open(traceFileName);
+    }
+    std::istream &input = (traceFileName == "-") ? std::cin : traceFile;
+
+    unsigned long totalAccesses = 0;
+    unsigned long totalHits = 0;
+    unsigned long totalMisses = 0;
+    unsigned long totalCycles = 0;
+
+    // The prefetcher sees the results of every access in order, and coherence crosses sets,
+    // so both need the sequential simulation
+    unsigned int concurrentThreads = opt.getConcurrentThreads();
+    if ( concurrentThreads > 1 && (prefetcher || multicore || hierarchy.hasInclusionPolicies()) && !sweeping ) {
+        std::cout << (prefetcher ? "Prefetching" : multicore ? "Coherence" : "Inclusion across levels")
+                  << " is only supported by the sequential simulation, using 1 thread" << std::endl;
+        concurrentThreads = 1;
+    }
+
+    // Records are parsed by the reader thread while we simulate
+    TraceReader reader(input, opt.getBufferedChunks(), concurrentThreads > 1 ? PARALLEL_CHUNK_SIZE : MIN_CHUNK_SIZE);
+    reader.start();
+
+    bool warming = opt.getWarmupRecords() > 0 || opt.getWarmupSeqNumber() > 0;
+    if ( (warming || !opt.getLoadSnapshotFile().empty()) && sweeping ) {
+        std::cout << "Warmups and snapshots are not supported by sweeps. Exiting..." << std::endl;
+        exit(1);
+    }
+    if ( sweeping ) {
+        return runSweep(opt, model, hierarchy, reader);
+    }
+
+    // A snapshot replaces the warmup, whose records are then skipped
+    bool snapshotLoaded = !opt.getLoadSnapshotFile().empty();
+    if ( (snapshotLoaded || !opt.getSaveSnapshotFile().empty()) && multicore ) {
+        std::cout << "Snapshots are not supported in multicore mode. Exiting..." << std::endl;
+        exit(1);
+    }
+    if ( snapshotLoaded && !hierarchy.loadSnapshot(opt.getLoadSnapshotFile(), error) ) {
+        std::cout << "Cannot load the snapshot: " << error << ". Exiting..." << std::endl;
+        exit(1);
+    }
+
+    // Coherence needs the stores, with the default write policies if the model has none
+    bool simulateStores = model.simulatesStores() || multicore;
+    // Wide accesses are split in chunks of the first level line size, or at line boundaries
+    // with coalescing, which also merges the elements of a bundle that share a line
+    AccessSplitter splitter(model.getLevel(0).lineBytes(), opt.isCoalescing(), simulateStores);
+    unsigned long bundleCycles = 0;
+    // Total Cycles adds up the latencies of all the accesses, the timing model overlaps them
+    std::unique_ptr<TimingModel> timing;
+    if ( opt.isTiming() ) {
+        timing = std::unique_ptr<TimingModel>(new TimingModel(model));
+    }
+    // Translations, if the model has TLB levels
+    std::unique_ptr<Tlb> tlb;
+    if ( model.getNumTlbLevels() > 0 ) {
+        tlb = std::unique_ptr<Tlb>(new Tlb(model));
+    }
+    // Counters per PC of the demand accesses
+    std::unique_ptr<PcProfile> pcProfile;
+    if ( opt.getTopPcs() > 0 ) {
+        pcProfile = std::unique_ptr<PcProfile>(new PcProfile(numLevels));
+    }
+
+    // Functional warming: the caches are updated, and the counters cleared at the end
+    unsigned long warmupRecords = opt.getWarmupRecords();
+    unsigned long warmupSeqNumber = opt.getWarmupSeqNumber();
+    bool warmupDone = false;
+    auto endWarmup = [&]() {
+        if ( !opt.getSaveSnapshotFile().empty() && !hierarchy.saveSnapshot(opt.getSaveSnapshotFile(), error) ) {
+            std::cout << "Cannot save the snapshot: " << error << ". Exiting..." << std::endl;
+            exit(1);
+        }
+        hierarchy.resetStats();
+        if ( multicore ) {
+            multicore->resetStats();
+        }
+        if ( tlb ) {
+            tlb->resetStats();
+        }
+        if ( sampler ) {
+            sampler->resetStats();
+        }
+        if ( timing ) {
+            timing = std::unique_ptr<TimingModel>(new TimingModel(model));
+        }
+        if ( pcProfile ) {
+            pcProfile->clear();
+        }
+        splitter.resetStats();
+        totalAccesses = 0;
+        totalHits = 0;
+        totalMisses = 0;
+        totalCycles = 0;
+        bundleCycles = 0;
+    };
+
+    std::vector<memRecord> chunk;
+    // Records of the chunk where the warmup ends that come after it
+    std::vector<memRecord> measured;
+    bool haveMeasured = false;
+    std::vector<Access> accesses;
+    std::vector<Request> demands;
+    std::vector<unsigned int> hitLevels;
+    bool more = true;
+    while ( more ) {
+        if ( warmupDone ) {
+            endWarmup();
+            warmupDone = false;
+        }
+        // The last bundle of the trace may have no end
+        accesses.clear();
+        if ( haveMeasured ) {
+            chunk.swap(measured);
+            haveMeasured = false;
+        } else {
+            more = reader.next(chunk);
+        }
+        if ( warming && more ) {
+            unsigned long end = 0;
+            if ( warmupSeqNumber > 0 ) {
+                while ( end < chunk.size() && chunk[end].seqNumber < warmupSeqNumber ) {
+                    end++;
+                }
+            } else {
+                end = std::min((unsigned long) chunk.size(), warmupRecords);
+                warmupRecords -= end;
+            }
+            if ( end < chunk.size() ) {
+                measured.assign(chunk.begin() + end, chunk.end());
+                chunk.resize(end);
+                haveMeasured = true;
+                warming = false;
+                warmupDone = true;
+            }
+            if ( snapshotLoaded ) {
+                chunk.clear();
+            }
+        }
+        if ( more ) {
+            splitter.split(chunk, accesses);
+        } else {
+            splitter.finish(accesses);
+        }
+        if ( sampler ) {
+            unsigned int sampled = 0;
+            for ( unsigned int i = 0; i < accesses.size(); i++ ) {
+                if ( sampler->sample(accesses[i].address, accesses[i].address) ) {
+                    accesses[sampled++] = accesses[i];
+                }
+            }
+            accesses.resize(sampled);
+        }
+
+        if ( concurrentThreads > 1 ) {
+            demands.clear();
+            for ( unsigned int i = 0; i < accesses.size(); i++ ) {
+                const Access &access = accesses[i];
+                Request demand = { access.address, access.bytes,
+                    access.isWrite ? (unsigned int) WRITE_REQUEST : (unsigned int) READ_REQUEST, i };
+                demands.push_back(demand);
+            }
+
+            hierarchy.accessBatch(demands, hitLevels, concurrentThreads);
+            for ( unsigned int i = 0; i < hitLevels.size(); i++ ) {
+                unsigned long latency = hierarchy.getLatency(hitLevels[i]);
+                if ( tlb ) {
+                    latency += tlb->translate(accesses[i].address, getAccessClass(accesses[i]));
+                }
+                totalCycles += latency;
+                if ( timing ) {
+                    timing->access(hitLevels[i], latency);
+                }
+                if ( sampler ) {
+                    sampler->record(accesses[i].address, hitLevels[i] >= numLevels, latency);
+                }
+                if ( pcProfile ) {
+                    pcProfile->record(accesses[i].pc, hitLevels[i], latency);
+                }
+                if ( accesses[i].inBundle ) {
+                    bundleCycles += latency;
+                }
+                if ( hitLevels[i] < numLevels ) {
+                    totalHits++;
+                } else {
+                    totalMisses++;
+                }
+            }
+            totalAccesses += hitLevels.size();
+            continue;
+        }
+
+        for ( unsigned int i = 0; i < accesses.size(); i++ ) {
+            const Access &access = accesses[i];
+            unsigned int level;
+            if ( multicore ) {
+                level = multicore->access(access.threadId, access.address, access.isWrite, access.bytes);
+            } else {
+                hierarchy.setCycle(totalCycles);
+                // Stores are only simulated if the model asks for it
+                if ( simulateStores ) {
+                    level = hierarchy.access(access.address, access.isWrite, access.bytes);
+                } else {
+                    level = hierarchy.access(access.address);
+                }
+            }
+            unsigned long latency = multicore ? multicore->getLatency(level) : hierarchy.getLatency(level);
+            if ( tlb ) {
+                latency += tlb->translate(access.address, getAccessClass(access));
+            }
+            totalCycles += latency;
+            if ( timing ) {
+                timing->access(level, latency);
+            }
+            if ( sampler ) {
+                sampler->record(access.address, level >= numLevels, latency);
+            }
+            if ( pcProfile ) {
+                pcProfile->record(access.pc, level, latency);
+            }
+            if ( access.inBundle ) {
+                bundleCycles += latency;
+            }
+            if ( level < numLevels ) {
+                totalHits++;
+            } else {
+                totalMisses++;
+            }
+            totalAccesses++;
+
+            if ( prefetcher ) {
+                prefetches.clear();
+                prefetcher->observe(access.address, access.pc, level > 0, prefetches);
+                for ( unsigned int j = 0; j < prefetches.size(); j++ ) {
+                    hierarchy.prefetch(prefetches[j]);
+                }
+            }
+        }
+    }
+
+    if ( warming ) {
+        std::cout << "The trace ended during the warmup" << std::endl;
+        endWarmup();
+    }
+
+    /*
+     * Print a report, same format as sve-cachesim.py
+     */
+    std::stringstream report;
+    std::string runName = model.getName() + "-" + traceFileName;
+    if ( prefetcher ) {
+        runName += "." + prefetcherName;
+    }
+    report << "========" << std::endl << runName << std::endl << "========" << std::endl;
+    unsigned long memReadBytes = multicore ? multicore->getMemReadBytes() : hierarchy.getMemReadBytes();
+    unsigned long memWriteBytes = multicore ? multicore->getMemWriteBytes() : hierarchy.getMemWriteBytes();
+    if ( sampler ) {
+        // Estimates of the full simulation
+        totalAccesses = sampler->scale(totalAccesses);
+        totalHits = sampler->scale(totalHits);
+        totalMisses = sampler->scale(totalMisses);
+        totalCycles = sampler->scale(totalCycles);
+        memReadBytes = sampler->scale(memReadBytes);
+        memWriteBytes = sampler->scale(memWriteBytes);
+        bundleCycles = sampler->scale(bundleCycles);
+    }
+    for ( unsigned int level = 0; level < numLevels; level++ ) {
+        LevelStats stats = multicore ? multicore->getStats(level) : hierarchy.getStats(level);
+        if ( sampler ) {
+            stats.hits = sampler->scale(stats.hits);
+            stats.accesses = sampler->scale(stats.accesses);
+            stats.evicts = sampler->scale(stats.evicts);
+            stats.writeAccesses = sampler->scale(stats.writeAccesses);
+            stats.writeHits = sampler->scale(stats.writeHits);
+            stats.writebacks = sampler->scale(stats.writebacks);
+            stats.replacements = sampler->scale(stats.replacements);
+            stats.backInvalidations = sampler->scale(stats.backInvalidations);
+            stats.victimFills = sampler->scale(stats.victimFills);
+        }
+        report << "l" << level + 1 << " Hits\t\t" << stats.hits << std::endl;
+        report << "l" << level + 1 << " Accesses\t" << stats.accesses << std::endl;
+        report << "l" << level + 1 << " Evicts\t" << stats.evicts << std::endl;
+        if ( prefetcher && (int) level == fetchLevel ) {
+            report << "l" << level + 1 << " Prefetch Evicts\t" << stats.prefetchEvicts << std::endl;
+        }
+        report << "l" << level + 1 << " Hit Rate\t" << percentage(stats.hits, stats.accesses) << std::endl;
+        report << "l" << level + 1 << " Miss Rate\t" << percentage(stats.accesses - stats.hits, stats.accesses) << std::endl;
+        report << "l" << level + 1 << " Evict Rate\t" << percentage(stats.evicts, stats.accesses) << std::endl;
+        if ( simulateStores ) {
+            report << "l" << level + 1 << " Write Accesses\t" << stats.writeAccesses << std::endl;
+            report << "l" << level + 1 << " Write Hits\t" << stats.writeHits << std::endl;
+            report << "l" << level + 1 << " Writebacks\t" << stats.writebacks << std::endl;
+        }
+        if ( model.hasInclusionPolicies() ) {
+            // Evicts keeps the meaning of sve-cachesim.py (misses), these are the valid lines replaced
+            const CacheConfig &config = model.getLevel(level);
+            report << "l" << level + 1 << " Replacements\t" << stats.replacements << std::endl;
+            if ( config.inclusive ) {
+                report << "l" << level + 1 << " Back-Invalidations\t" << stats.backInvalidations << std::endl;
+            }
+            if ( config.exclusive ) {
+                report << "l" << level + 1 << " Victim Fills\t" << stats.victimFills << std::endl;
+            }
+        }
+        report << std::endl;
+    }
+    report << "Total Accesses\t" << totalAccesses << std::endl;
+    report << "Total Hits\t" << totalHits << std::endl;
+    report << "Total Misses\t" << totalMisses << std::endl;
+    report << "Total Cycles\t" << (timing ? timing->getCycles() : totalCycles) << std::endl;
+    if ( timing ) {
+        report << "Serialized Cycles\t" << totalCycles << std::endl;
+        report << "MLP\t\t" << std::fixed << std::setprecision(2) << timing->getMlp() << std::endl;
+        report << "Memory Bytes/Cycle\t" << std::fixed << std::setprecision(2) << timing->getBandwidth() << std::endl;
+    }
+    if ( simulateStores ) {
+        report << "Memory Read Bytes\t" << memReadBytes << std::endl;
+        report << "Memory Write Bytes\t" << memWriteBytes << std::endl;
+    }
+    if ( sampler ) {
+        report << "Sampled Accesses\t" << sampler->getSampledAccesses() << std::endl;
+        report << "Sampling Ratio\t1/" << opt.getSampleRatio() << (opt.isHashedSampling() ? " hashed" : "") << std::endl;
+        report << "Total Misses 95% CI\t+/- " << (unsigned long) (sampler->getMissesInterval() + 0.5) << std::endl;
+        report << "Total Cycles 95% CI\t+/- " << (unsigned long) (sampler->getCyclesInterval() + 0.5) << std::endl;
+    }
+    if ( multicore ) {
+        const CoherenceStats &coherenceStats = multicore->getCoherenceStats();
+        report << "Cores\t\t" << multicore->getNumCores() << std::endl;
+        report << "Upgrades\t" << coherenceStats.upgrades << std::endl;
+        report << "Invalidations\t" << coherenceStats.invalidations << std::endl;
+        report << "Coherence Misses\t" << coherenceStats.coherenceMisses << std::endl;
+        report << "Coherence Writebacks\t" << coherenceStats.coherenceWritebacks << std::endl;
+    }
+    if ( tlb ) {
+        // Per access class, only those that were simulated
+        for ( unsigned int type = 0; type < NUM_ACCESS_CLASSES; type++ ) {
+            const TlbStats &tlbStats = tlb->getStats((accessClass) type);
+            if ( tlbStats.accesses == 0 ) {
+                continue;
+            }
+            std::string className = Tlb::getClassName((accessClass) type);
+            report << className << " TLB Accesses\t" << tlbStats.accesses << std::endl;
+            for ( unsigned int level = 0; level < tlb->getNumLevels(); level++ ) {
+                report << className << " tlb" << level + 1 << " Hits\t" << tlbStats.hits[level] << std::endl;
+            }
+            report << className << " Page Walks\t" << tlbStats.pageWalks << std::endl;
+            report << className << " TLB Miss Rate\t" << percentage(tlbStats.pageWalks, tlbStats.accesses) << std::endl;
+            report << className << " TLB Cycles\t" << tlbStats.cycles << std::endl;
+        }
+    }
+    if ( opt.isCoalescing() ) {
+        // Latency of the bundle requests spread over the elements that share them
+        report << "Bundles\t\t" << splitter.getBundles() << std::endl;
+        report << "Bundle Elements\t" << splitter.getElements() << std::endl;
+        report << "Coalesced Requests\t" << splitter.getCoalescedRequests() << std::endl;
+        report << "Uncoalesced Requests\t" << splitter.getUncoalescedRequests() << std::endl;
+        report << "Average Element Latency\t" << std::fixed << std::setprecision(2)
+               << (splitter.getElements() ? (double) bundleCycles / splitter.getElements() : 0.0) << std::endl;
+    }
+    if ( prefetcher ) {
+        // Accuracy: prefetched lines used before being replaced. Coverage: fetch level misses removed.
+        // Timeliness: used prefetches that had arrived when the demand access came
+        const PrefetchStats &prefetchStats = hierarchy.getPrefetchStats();
+        unsigned long fetchLevelMisses = hierarchy.getStats(fetchLevel).evicts;
+        report << "Prefetch Requests\t" << prefetchStats.requests << std::endl;
+        report << "Prefetch Fills\t" << prefetchStats.fills << std::endl;
+        report << "Useful Prefetches\t" << prefetchStats.useful << std::endl;
+        report << "Late Prefetches\t" << prefetchStats.late << std::endl;
+        report << "Prefetch Accuracy\t" << percentage(prefetchStats.useful, prefetchStats.fills) << std::endl;
+        report << "Prefetch Coverage\t" << percentage(prefetchStats.useful, prefetchStats.useful + fetchLevelMisses) << std::endl;
+        report << "Prefetch Timeliness\t" << percentage(prefetchStats.useful - prefetchStats.late, prefetchStats.useful) << std::endl;
+    }
+
+    if ( pcProfile ) {
+        // Serialized cycles, like Total Cycles without the timing model
+        report << std::endl;
+        pcProfile->printReport(report, opt.getTopPcs(),
+            sampler && sampler->getSampledAccesses() ? (double) sampler->getAccesses() / sampler->getSampledAccesses() : 1.0);
+    }
+
+    std::cout << report.str();
+    if ( !opt.getOutFile().empty() ) {
+        std::ofstream outputFile(opt.getOutFile());
+        outputFile << report.str();
+        outputFile.close();
+    }
+
+    return 0;
+}
@@ -16,6 +16,8 @@
 
 # Common Stride Prefetcher Plugin for the SVE cache Simulator
 
+import itertools
+
 # Avoids compatibility issues with Counter.most_common() and equally common strides between different python versions
 def most_common(l):
     d = {}
@@ -37,7 +39,8 @@ def plugin_prefetch(UsedAddress):  # this MUST be the name given
 
     stride = []
     # chunk of read addresses to examine for stride length
-    chunk = UsedAddress[begin:]
+    # (UsedAddress may be a list or a deque, which cannot be sliced)
+    chunk = list(itertools.islice(UsedAddress, begin, None))
     for i in range(0, len(chunk) - 1):
         length = chunk[i + 1] - chunk[i]
         if length != 0:
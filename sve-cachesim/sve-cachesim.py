@@ -16,7 +16,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
-from collections import defaultdict
+from collections import defaultdict, deque
 import argparse
 from argparse import RawTextHelpFormatter
 import re
@@ -24,6 +24,7 @@ import os
 import errno
 import json
 import gzip
+import sys
 
 
 def load_plugin(name):
@@ -32,52 +33,42 @@ def load_plugin(name):
 
 
 def traceToInts(filename, cache_size, zip_trace):
-    # create list of instruction addresses (as hex) and of data read addresses (converted to ints)
+    # generate data read addresses (converted to ints), one at a time,
+    # so that memory use does not depend on the trace length
 
     # Trace Format:
     # <seq num>: <TID>, <is_Bundle>, <is_Write>, <data_size>, <data_address>, <PC>
-    r_addresses = []  # data read addresses (int)
-
-    # Process gzipped/unzipped memtraces
-    if zip_trace:
-        with gzip.open(filename, "rb") as trace:
-            for line in trace:
-                split = [item.strip()
-                         for item in re.split(':|,', line.decode("utf-8"))]
-                if len(split[3]) == 1:
-                    if int(split[3]) == 0:  # read trace
-                        # Address from trace (to be chunked)
-                        r_addresses.append(int(split[5], 16))
-
-                        # Chunk the read access into multiple reads if size is too large for cache
-                        nextAddr = int(split[5], 16)  # iterator
-                        # read_trace size - (cache lineSize * wordSize)
-                        size = int(split[4]) - cache_size
-                        while size > 0:
-                            nextAddr += cache_size
-                            size -= cache_size
-                            # chunked memory addresses
-                            r_addresses.append(nextAddr)
+
+    # Process gzipped/unzipped memtraces, "-" reads from stdin
+    if filename == "-":
+        if zip_trace:
+            trace = gzip.GzipFile(fileobj=sys.stdin.buffer)
+        else:
+            trace = sys.stdin
+    elif zip_trace:
+        trace = gzip.open(filename, "rb")
     else:
-        with open(filename, "r") as trace:
-            for line in trace:
-                split = [item.strip() for item in re.split(':|,', line)]
-                if len(split[3]) == 1:
-                    if int(split[3]) == 0:  # read trace
-                        # Address from trace (to be chunked)
-                        r_addresses.append(int(split[5], 16))
-
-                        # Chunk the read access into multiple reads if size is too large for cache
-                        nextAddr = int(split[5], 16)  # iterator
-                        # read_trace size - (cache lineSize * wordSize)
-                        size = int(split[4]) - cache_size
-                        while size > 0:
-                            nextAddr += cache_size
-                            size -= cache_size
-                            # chunked memory addresses
-                            r_addresses.append(nextAddr)
-
-    return r_addresses
+        trace = open(filename, "r")
+
+    with trace:
+        for line in trace:
+            if zip_trace:
+                line = line.decode("utf-8")
+            split = [item.strip() for item in re.split(':|,', line)]
+            if len(split[3]) == 1:
+                if int(split[3]) == 0:  # read trace
+                    # Address from trace (to be chunked)
+                    nextAddr = int(split[5], 16)  # iterator
+                    yield nextAddr
+
+                    # Chunk the read access into multiple reads if size is too large for cache
+                    # read_trace size - (cache lineSize * wordSize)
+                    size = int(split[4]) - cache_size
+                    while size > 0:
+                        nextAddr += cache_size
+                        size -= cache_size
+                        # chunked memory addresses
+                        yield nextAddr
 
 
 class CacheConfig:
@@ -164,7 +155,8 @@ def main():
     parser = argparse.ArgumentParser(description='SVE CacheSim\n \
   <usage> python sve-cachesim.py <memtrace-file> <cache-model.json> \n',
                                      formatter_class=RawTextHelpFormatter)
-    parser.add_argument('memtrace', type=str, help='ArmIE memory trace file')
+    parser.add_argument('memtrace', type=str,
+                        help='ArmIE memory trace file (- for stdin)')
     parser.add_argument('model', type=str,
                         help='Cache model JSON file')
     parser.add_argument('-p', '--prefetch', type=str,
@@ -183,7 +175,8 @@ def main():
 
     json_data = open(args.model)
     data = json.load(json_data)
-    UsedAddress = []
+    # The prefetcher only looks at the latest 100 addresses
+    UsedAddress = deque(maxlen=100)
     cache_model = []
 
     # create empty cache model using data in config file
@@ -194,6 +187,7 @@ def main():
     hitcount = [0] * data[0]["nlevels"]
     accessCount = [0] * data[0]["nlevels"]
     prefetcherAccessCount = 0  # only LLC accesses
+    total_accesses = 0
     total_hits = 0
     total_misses = 0
     totalCycles = 0
@@ -213,11 +207,7 @@ def main():
     for addr in addresses:  # Parse each read address (includes chunks if any)
         # keep record of addresses accessed
         UsedAddress.append(addr)
-        # addr is int (5k ints ~ 160kb)
-        # Since the prefetcher is only using the latest 100 addresses,
-        # Trim the list to save memory when using prefetcher
-        if len(UsedAddress) >= 5000:
-            UsedAddress = UsedAddress[4899:]
+        total_accesses += 1
 
         # Use prefetcher if requested
         if args.prefetch:
@@ -271,7 +261,7 @@ def main():
         print("l{} Evict Rate\t{:.2%}\n".format(
             n + 1, 1.0 * cache_model[n].evictCounter / accessCount[n]))
 
-    print("Total Accesses\t{}".format(len(addresses)))
+    print("Total Accesses\t{}".format(total_accesses))
     print("Total Hits\t{}".format(total_hits))
     print("Total Misses\t{}".format(total_misses))
     print("Total Cycles\t{}".format(totalCycles))
@@ -299,7 +289,7 @@ def main():
                                                          * (accessCount[n] - hitcount[n]) / accessCount[n]))
                 f.write("l{} Evict Rate\t{:.2%}\n\n".format(
                     n + 1, 1.0 * cache_model[n].evictCounter / accessCount[n]))
-            f.write("Total Accesses\t{}\n".format(len(addresses)))
+            f.write("Total Accesses\t{}\n".format(total_accesses))
             f.write("Total Hits\t{}\n".format(total_hits))
             f.write("Total Misses\t{}\n".format(total_misses))
             f.write("Total Cycles\t{}\n".format(totalCycles))
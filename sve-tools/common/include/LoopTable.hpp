@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LOOPTABLE_HPP
+#define LOOPTABLE_HPP
+
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <algorithm>
+
+/*
+ * Loops found from the backward transfers of a trace
+ *
+ * A taken transfer to a lower PC closes a loop from its target (the header) to
+ * the branch, unless the branch is a call or a return. All the transfers to the
+ * same header make one loop, which ends after the last of their branches. Loops
+ * are numbered by header address, and nest: the parent of a loop is the smallest
+ * other loop that contains it. Shared by loop_finder, flops_byte and inst_mix.
+ */
+class LoopTable {
+  public:
+    struct loop {
+        unsigned long start;       // header
+        unsigned long end;         // past the last backward branch
+        int parent;                // -1 for outermost loops
+        unsigned long entries;
+        unsigned long iterations;
+        unsigned long minTrip;
+        unsigned long maxTrip;
+        unsigned long instructions;      // of the PCs this loop is the innermost one for
+        unsigned long memInstructions;
+    };
+
+  private:
+    std::map<unsigned long, unsigned long> ends;       // header => end, while the trace is read
+    std::vector<loop> loops;
+    std::unordered_map<unsigned long, int> headers;    // header => loop ID
+    std::vector<int> bySize;                           // loop IDs, smallest first
+    std::unordered_map<unsigned long, int> innermost;  // PC => loop ID, filled as PCs are looked up
+
+    bool smaller(int a, int b) const {
+        if ( loops[a].end - loops[a].start != loops[b].end - loops[b].start ) {
+            return loops[a].end - loops[a].start < loops[b].end - loops[b].start;
+        }
+        return a < b;
+    }
+
+  public:
+    static bool isCall(unsigned int e) {
+        return (e & 0xFC000000) == 0x94000000 ||   // bl
+               (e & 0xFFFFFC1F) == 0xD63F0000;     // blr
+    }
+
+    static bool isReturn(unsigned int e) {
+        return (e & 0xFFFFFC1F) == 0xD65F0000;     // ret
+    }
+
+    // Whether going from the previous instruction to pc closes a loop. Calls and returns
+    // may go backwards too
+    static bool isBackwardTransfer(unsigned long pc, unsigned long previousPc, unsigned int previousEncoding) {
+        return pc < previousPc && !isCall(previousEncoding) && !isReturn(previousEncoding);
+    }
+
+    void addBackwardTransfer(unsigned long target, unsigned long source) {
+        unsigned long &end = ends[target];
+        end = std::max(end, source + 4);
+    }
+
+    // Adds the transfers of another table not built yet, e.g. one filled by another thread
+    void merge(const LoopTable &other) {
+        for ( std::map<unsigned long, unsigned long>::const_iterator it = other.ends.begin(); it != other.ends.end(); it++ ) {
+            unsigned long &end = ends[it->first];
+            end = std::max(end, it->second);
+        }
+    }
+
+    // Number the loops and link them to their parents, once every transfer was added
+    void build() {
+        for ( std::map<unsigned long, unsigned long>::iterator it = ends.begin(); it != ends.end(); it++ ) {
+            headers[it->first] = loops.size();
+            bySize.push_back(loops.size());
+            loops.push_back(loop{ it->first, it->second, -1, 0, 0, 0, 0, 0, 0 });
+        }
+        ends.clear();
+        std::sort(bySize.begin(), bySize.end(), [this](int a, int b) { return smaller(a, b); });
+
+        // The first larger loop containing a loop is its parent
+        for ( unsigned int i = 0; i < bySize.size(); i++ ) {
+            loop &child = loops[bySize[i]];
+            for ( unsigned int j = i + 1; j < bySize.size(); j++ ) {
+                const loop &candidate = loops[bySize[j]];
+                if ( candidate.start <= child.start && child.end <= candidate.end ) {
+                    child.parent = bySize[j];
+                    break;
+                }
+            }
+        }
+    }
+
+    // ID of the loop whose header is pc, -1 if none
+    int header(unsigned long pc) const {
+        std::unordered_map<unsigned long, int>::const_iterator it = headers.find(pc);
+        return it == headers.end() ? -1 : it->second;
+    }
+
+    // ID of the innermost loop containing pc, -1 if none does
+    int find(unsigned long pc) {
+        std::unordered_map<unsigned long, int>::iterator it = innermost.find(pc);
+        if ( it != innermost.end() ) {
+            return it->second;
+        }
+        int id = -1;
+        for ( unsigned int i = 0; i < bySize.size(); i++ ) {
+            if ( contains(bySize[i], pc) ) {
+                id = bySize[i];
+                break;
+            }
+        }
+        innermost[pc] = id;
+        return id;
+    }
+
+    bool contains(int id, unsigned long pc) const {
+        return pc >= loops[id].start && pc < loops[id].end;
+    }
+
+    unsigned int size() const {
+        return loops.size();
+    }
+
+    loop &operator[](unsigned int i) {
+        return loops[i];
+    }
+};
+
+#endif
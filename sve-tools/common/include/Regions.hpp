@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef REGIONS_HPP
+#define REGIONS_HPP
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <algorithm>
+#include <cstdlib>
+
+/*
+ * Named PC ranges: functions, from a symbol table, or loops
+ *
+ * Ranges are [start, end). They may nest; a PC belongs to the smallest range
+ * that contains it. Region files have one region per line:
+ *     <start>,<end>,<name>
+ * with the addresses in hexadecimal (e.g. from `nm -S`). Lines starting with
+ * '#' are comments.
+ */
+class Regions {
+  public:
+    struct region {
+        unsigned long start;
+        unsigned long end;
+        std::string name;
+    };
+
+  private:
+    std::vector<region> regions;
+    bool sorted;
+
+    static bool smaller(const region &a, const region &b) {
+        if ( a.end - a.start != b.end - b.start ) {
+            return a.end - a.start < b.end - b.start;
+        }
+        return a.start < b.start;
+    }
+
+  public:
+    Regions() : sorted(true) {
+    }
+
+    void add(unsigned long start, unsigned long end, const std::string &name) {
+        if ( end > start ) {
+            regions.push_back(region{ start, end, name });
+            sorted = false;
+        }
+    }
+
+    // Returns false if the file cannot be read
+    bool load(const std::string &fileName) {
+        std::ifstream file(fileName);
+        if ( !file.is_open() ) {
+            return false;
+        }
+        std::string line;
+        while ( std::getline(file, line) ) {
+            if ( line.empty() || line[0] == '#' ) {
+                continue;
+            }
+            size_t first = line.find(',');
+            size_t second = first == std::string::npos ? std::string::npos : line.find(',', first + 1);
+            if ( second == std::string::npos ) {
+                continue;
+            }
+            unsigned long start = std::strtoul(line.c_str(), NULL, 16);
+            unsigned long end = std::strtoul(line.c_str() + first + 1, NULL, 16);
+            add(start, end, line.substr(second + 1));
+        }
+        return true;
+    }
+
+    // Index of the innermost region containing pc, -1 if none does
+    int find(unsigned long pc) {
+        if ( !sorted ) {
+            std::sort(regions.begin(), regions.end(), smaller);
+            sorted = true;
+        }
+        for ( unsigned int i = 0; i < regions.size(); i++ ) {
+            if ( pc >= regions[i].start && pc < regions[i].end ) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    unsigned int size() {
+        return regions.size();
+    }
+
+    const region &operator[](unsigned int i) {
+        return regions[i];
+    }
+};
+
+#endif
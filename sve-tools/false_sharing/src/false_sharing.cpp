@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Options.hpp"
+#include "Utils.hpp"
+
+#include <fstream>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+
+#include <pthread.h>
+
+#define MIN_CHUNK_SIZE 10000
+
+enum conflictType { READ_AFTER_WRITE = 0, WRITE_AFTER_WRITE = 1, WRITE_AFTER_READ = 2, NUM_CONFLICT_TYPES = 3 };
+
+// Last access of one kind (read or write) to a line. Record 0 means there was none
+struct lineAccess {
+    unsigned long record;
+    unsigned long mask;
+    unsigned long pc;
+    unsigned int threadId;
+};
+
+// One entry of the line table, indexed by line address
+struct lineEntry {
+    unsigned long line;
+    lineAccess lastWrite;
+    lineAccess lastRead;
+};
+
+struct sharingInformation {
+    unsigned long trueSharing;
+    unsigned long falseSharing;
+    // Bit (TID % 64) is set for every thread involved
+    unsigned long threadMask;
+};
+
+std::string outputFileName;
+std::ofstream outputFile;
+
+// The analysis is sequential: while one chunk is analyzed the next one is being read
+std::vector<std::string> chunk;
+
+unsigned long window;
+unsigned int lineBits;
+// Each bit of an access mask covers this many bytes (log2), so that a line fits in 64 bits
+unsigned int granuleBits;
+unsigned long tableMask;
+std::vector<lineEntry> lineTable;
+
+unsigned long currentRecord;
+unsigned long totalAccesses;
+unsigned long trueSharing[NUM_CONFLICT_TYPES];
+unsigned long falseSharing[NUM_CONFLICT_TYPES];
+
+// Key => line address
+std::unordered_map<unsigned long, sharingInformation> lineInformation;
+
+// Key => (PC of the previous access from another thread, PC of the access)
+std::map<std::pair<unsigned long, unsigned long>, sharingInformation> pcPairInformation;
+
+unsigned long tableIndex ( unsigned long line ) {
+    return ((line * 0x9E3779B97F4A7C15UL) >> 24) & tableMask;
+}
+
+bool isRecent ( lineAccess &previous, unsigned int threadId ) {
+    return previous.record != 0 && previous.threadId != threadId && currentRecord - previous.record <= window;
+}
+
+void recordConflict ( unsigned long line, lineAccess &previous, lineAccess &current, int type ) {
+    bool isTrueSharing = (previous.mask & current.mask) != 0;
+
+    sharingInformation &lineInfo = lineInformation[line];
+    sharingInformation &pcInfo = pcPairInformation[std::make_pair(previous.pc, current.pc)];
+    if ( isTrueSharing ) {
+        trueSharing[type]++;
+        lineInfo.trueSharing++;
+        pcInfo.trueSharing++;
+    } else {
+        falseSharing[type]++;
+        lineInfo.falseSharing++;
+        pcInfo.falseSharing++;
+    }
+    lineInfo.threadMask |= (1UL << (previous.threadId % 64)) | (1UL << (current.threadId % 64));
+    pcInfo.threadMask |= (1UL << (previous.threadId % 64)) | (1UL << (current.threadId % 64));
+}
+
+void analyzeAccess ( memRecord &record ) {
+    if ( record.dataSize == 0 ) {
+        return;
+    }
+    unsigned long lineOffsetMask = (1UL << lineBits) - 1;
+    unsigned long firstByte = record.dataAddress;
+    unsigned long lastByte = record.dataAddress + record.dataSize - 1;
+
+    for ( unsigned long line = firstByte >> lineBits; line <= (lastByte >> lineBits); line++ ) {
+        // Bytes of this line touched by the access
+        unsigned int lo = (line == (firstByte >> lineBits)) ? (firstByte & lineOffsetMask) >> granuleBits : 0;
+        unsigned int hi = (line == (lastByte >> lineBits)) ? (lastByte & lineOffsetMask) >> granuleBits : 63;
+        lineAccess current;
+        current.record = currentRecord;
+        current.mask = ((~0UL) >> (63 - hi)) & ((~0UL) << lo);
+        current.pc = record.pc;
+        current.threadId = record.threadId;
+
+        lineEntry &entry = lineTable[tableIndex(line)];
+        if ( entry.line != line ) {
+            // Evict whatever line was using the entry
+            entry.line = line;
+            entry.lastWrite.record = 0;
+            entry.lastRead.record = 0;
+        }
+
+        if ( record.isWrite == 1 ) {
+            // A write conflicting with both a read and a write is counted once, as a write after write
+            if ( isRecent(entry.lastWrite, record.threadId) ) {
+                recordConflict(line, entry.lastWrite, current, WRITE_AFTER_WRITE);
+            } else if ( isRecent(entry.lastRead, record.threadId) ) {
+                recordConflict(line, entry.lastRead, current, WRITE_AFTER_READ);
+            }
+            entry.lastWrite = current;
+        } else {
+            if ( isRecent(entry.lastWrite, record.threadId) ) {
+                recordConflict(line, entry.lastWrite, current, READ_AFTER_WRITE);
+            }
+            entry.lastRead = current;
+        }
+    }
+}
+
+// Threaded analyzer. Records are analyzed in trace order, so only one of these runs at a time
+void *analyzeChunk ( void *unused ) {
+    memRecord record;
+    for ( int i = 0; i < chunk.size(); i++ ) {
+        if ( !parseLine(chunk[i], record) ) {
+            continue;
+        }
+        currentRecord++;
+        totalAccesses++;
+        analyzeAccess(record);
+    }
+
+    pthread_exit(NULL);
+}
+
+unsigned int countThreads ( unsigned long threadMask ) {
+    unsigned int threads = 0;
+    for ( ; threadMask != 0; threadMask &= threadMask - 1 ) {
+        threads++;
+    }
+    return threads;
+}
+
+bool moreFalseSharing ( const sharingInformation &a, const sharingInformation &b ) {
+    return a.falseSharing > b.falseSharing || (a.falseSharing == b.falseSharing && a.trueSharing > b.trueSharing);
+}
+
+void printReport ( std::ostream &os, unsigned int topEntries ) {
+    const char *conflictNames[NUM_CONFLICT_TYPES] = { "read after remote write", "write after remote write", "write after remote read" };
+    unsigned long totalTrueSharing = 0;
+    unsigned long totalFalseSharing = 0;
+
+    os << std::fixed;
+    os << std::setprecision(4);
+
+    os << "access type,true sharing,false sharing" << std::endl;
+    for ( int type = 0; type < NUM_CONFLICT_TYPES; type++ ) {
+        os << conflictNames[type] << "," << trueSharing[type] << "," << falseSharing[type] << std::endl;
+        totalTrueSharing += trueSharing[type];
+        totalFalseSharing += falseSharing[type];
+    }
+    os << "total," << totalTrueSharing << "," << totalFalseSharing << std::endl;
+    os << std::endl;
+    os << "Total Accesses          = " << totalAccesses << std::endl;
+    os << "Contended Accesses      = " << totalTrueSharing + totalFalseSharing << " ("
+       << (totalAccesses ? ((double)(totalTrueSharing + totalFalseSharing) / (double)totalAccesses) * 100 : 0.0) << "%)" << std::endl;
+    os << "Contended Lines         = " << lineInformation.size() << std::endl;
+
+    // Lines with most false sharing first
+    std::vector< std::pair<unsigned long, sharingInformation> > lines(lineInformation.begin(), lineInformation.end());
+    std::sort(lines.begin(), lines.end(),
+              [](const std::pair<unsigned long, sharingInformation> &a, const std::pair<unsigned long, sharingInformation> &b) {
+                  return moreFalseSharing(a.second, b.second) || (!moreFalseSharing(b.second, a.second) && a.first < b.first);
+              });
+
+    os << std::endl;
+    os << "line address,true sharing,false sharing,#threads" << std::endl;
+    for ( unsigned int i = 0; i < lines.size() && i < topEntries; i++ ) {
+        os << "0x" << std::hex << (lines[i].first << lineBits) << std::dec << "," << lines[i].second.trueSharing << ","
+           << lines[i].second.falseSharing << "," << countThreads(lines[i].second.threadMask) << std::endl;
+    }
+
+    std::vector< std::pair<std::pair<unsigned long, unsigned long>, sharingInformation> > pcPairs(pcPairInformation.begin(), pcPairInformation.end());
+    std::stable_sort(pcPairs.begin(), pcPairs.end(),
+                     [](const std::pair<std::pair<unsigned long, unsigned long>, sharingInformation> &a,
+                        const std::pair<std::pair<unsigned long, unsigned long>, sharingInformation> &b) {
+                         return moreFalseSharing(a.second, b.second);
+                     });
+
+    os << std::endl;
+    os << "previous PC,PC,true sharing,false sharing,#threads" << std::endl;
+    for ( unsigned int i = 0; i < pcPairs.size() && i < topEntries; i++ ) {
+        os << "0x" << std::hex << pcPairs[i].first.first << ",0x" << pcPairs[i].first.second << std::dec << ","
+           << pcPairs[i].second.trueSharing << "," << pcPairs[i].second.falseSharing << ","
+           << countThreads(pcPairs[i].second.threadMask) << std::endl;
+    }
+}
+
+int main (int argc, char *argv[]) {
+    Options opt;
+    opt.readOptions(argc, argv);
+
+    window = opt.getWindow();
+    lineBits = 0;
+    while ( (1U << lineBits) < opt.getLineSize() ) {
+        lineBits++;
+    }
+    granuleBits = lineBits > 6 ? lineBits - 6 : 0;
+    tableMask = opt.getTableEntries() - 1;
+    lineEntry emptyEntry = lineEntry();
+    emptyEntry.line = ~0UL;
+    lineTable = std::vector<lineEntry>(opt.getTableEntries(), emptyEntry);
+
+    currentRecord = 0;
+    totalAccesses = 0;
+    for ( int type = 0; type < NUM_CONFLICT_TYPES; type++ ) {
+        trueSharing[type] = 0;
+        falseSharing[type] = 0;
+    }
+
+    pthread_t analyzeThread;
+    bool runningChunk = false;
+
+    std::string traceFileName = opt.getTraceFile();
+    outputFileName = opt.getOutFile();
+
+    std::cout << "########################################" << std::endl;
+    std::cout << "#          SUMMARY                     #" << std::endl;
+    std::cout << "########################################" << std::endl;
+    std::cout << "# Window:                " << window << " accesses" << std::endl;
+    std::cout << "# Line size:             " << opt.getLineSize() << " bytes" << std::endl;
+    std::cout << "# Line table entries:    " << opt.getTableEntries() << std::endl;
+    std::cout << "# Memtrace file:         " << traceFileName << std::endl;
+    std::cout << "# Output:                " << (outputFileName.empty() ? "stdout" : outputFileName) << std::endl;
+#ifdef ENABLE_GZIP
+    std::cout << "# Zipped files:          " << (opt.isZipped() ? "YES" : "NO") << std::endl;
+#endif
+    std::cout << "########################################" << std::endl;
+
+    /*
+     * First of all, open files
+     */
+    std::ifstream traceFile(traceFileName);
+    if ( !outputFileName.empty() ) {
+        outputFile = std::ofstream(outputFileName);
+    }
+
+    std::string line;
+    std::vector<std::string> chunkContents;
+    chunkContents.clear();
+
+    int typeOfLine;
+    typeOfLine = readLine(traceFile, line);
+    while ( typeOfLine != END_OF_FILE ) {
+        chunkContents.push_back(line);
+        typeOfLine = readLine(traceFile, line);
+
+        /*
+         * If we've completed a chunk, wait for the previous one to be analyzed and hand it over
+         */
+        if ( chunkContents.size() >= MIN_CHUNK_SIZE ) {
+            if ( runningChunk ) {
+                pthread_join(analyzeThread, NULL);
+            }
+            chunk.swap(chunkContents);
+            chunkContents.clear();
+            pthread_create(&analyzeThread, NULL, analyzeChunk, NULL);
+            runningChunk = true;
+        }
+    }
+
+    // Analyze whatever was left when we reached EOF
+    if ( runningChunk ) {
+        pthread_join(analyzeThread, NULL);
+    }
+    chunk.swap(chunkContents);
+    pthread_create(&analyzeThread, NULL, analyzeChunk, NULL);
+    pthread_join(analyzeThread, NULL);
+
+    /*
+     * Print a report
+     */
+    if ( outputFileName.empty() ) {
+        printReport(std::cout, opt.getTopEntries());
+    } else {
+        printReport(outputFile, opt.getTopEntries());
+    }
+
+    traceFile.close();
+    if ( !outputFileName.empty() ) {
+        outputFile.close();
+    }
+
+    return 0;
+}
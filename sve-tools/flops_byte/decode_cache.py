@@ -0,0 +1,74 @@
+#!/usr/bin/python3
+
+# Copyright (c) 2019, Arm Limited and Contributors.
+#
+# SPDX-License-Identifier: Apache-2.0
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+
+# Decoded instructions, keyed by encoding.
+#
+# Keeps an in-memory dictionary of encoding -> (mnemonic, operands), backed by a
+# memo file that can be reused across runs. The native tools (DecodeCache.hpp)
+# read and write the same format, one entry per line:
+#     0x<encoding>\t<mnemonic>\t<operands>
+# with an empty mnemonic for encodings llvm-mc rejects. Lines starting with
+# '#' are comments.
+
+import os
+
+HEADER = '# Decoded instructions: 0x<encoding>\\t<mnemonic>\\t<operands>\n'
+
+
+class DecodeCache:
+    def __init__(self, path=None):
+        self.path = path
+        self.entries = {}
+        self.added = []
+        if path and os.path.exists(path):
+            self.load(path)
+
+    def load(self, path):
+        with open(path, 'r') as memo:
+            for line in memo:
+                if line.startswith('#'):
+                    continue
+                fields = line.rstrip('\n').split('\t', 2)
+                if len(fields) != 3:
+                    continue
+                self.entries[int(fields[0], 16)] = (fields[1], fields[2])
+        self.added = []
+
+    def get(self, encoding):
+        """(mnemonic, operands) of a known encoding, None if it is not cached.
+        The mnemonic is empty for invalid encodings."""
+        return self.entries.get(encoding)
+
+    def put(self, encoding, mnemonic, operands):
+        if encoding not in self.entries:
+            self.added.append(encoding)
+        self.entries[encoding] = (mnemonic, operands)
+
+    def save(self):
+        """Append the entries added since the file was loaded"""
+        if not self.path or not self.added:
+            return
+        exists = os.path.exists(self.path)
+        with open(self.path, 'a') as memo:
+            if not exists:
+                memo.write(HEADER)
+            for encoding in self.added:
+                mnemonic, operands = self.entries[encoding]
+                memo.write('0x{:08x}\t{}\t{}\n'.format(encoding, mnemonic, operands))
+        self.added = []
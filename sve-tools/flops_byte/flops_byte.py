@@ -35,6 +35,8 @@ import os
 import re
 import sys
 
+from decode_cache import DecodeCache
+
 DEBUG = False
 DEBUG_EXTRA = False
 
@@ -49,6 +51,7 @@ d_range = 32
 MAXSIZE = 0
 
 mc = ''
+cache = DecodeCache()
 
 
 def opcodeMask(opcode):
@@ -244,16 +247,34 @@ def encoding_to_bytes(encoding, reverse=True):
 
 
 def instr_decoder(ins_opcode):
-    mc_args = [mc, '-disassemble', '-triple=aarch64', '-mattr=+sve']
-    # Decode instruction to get register information
-    echo = subprocess.Popen(('echo', encoding_to_bytes(
-        int(ins_opcode, 0))), stdout=subprocess.PIPE)
-
-    decline = subprocess.check_output(
-        mc_args, stdin=echo.stdout, stderr=subprocess.STDOUT)
+    """Decoded instruction as 'mnemonic\toperands', None for invalid encodings."""
+    encoding = int(ins_opcode, 0)
+    entry = cache.get(encoding)
+    if entry is None:
+        if not mc:
+            sys.stderr.write('error: LLVM_MC env variable not set\n')
+            sys.exit(1)
+        mc_args = [mc, '-disassemble', '-triple=aarch64', '-mattr=+sve']
+        # Decode instruction to get register information
+        echo = subprocess.Popen(('echo', encoding_to_bytes(
+            encoding)), stdout=subprocess.PIPE)
+
+        decline = subprocess.check_output(
+            mc_args, stdin=echo.stdout, stderr=subprocess.STDOUT)
+
+        decline = decline.decode('ascii')
+        if 'invalid instruction encoding' in decline:
+            entry = ('', '')
+        else:
+            decline = decline.split('\t.text\n', 1)[
+                1].split('\n')[:-1][0].strip()
+            fields = decline.split('\t', 1)
+            entry = (fields[0], fields[1] if len(fields) > 1 else '')
+        cache.put(encoding, entry[0], entry[1])
 
-    decline = decline.decode('ascii')
-    return decline
+    if not entry[0]:
+        return None
+    return entry[0] + '\t' + entry[1] if entry[1] else entry[0]
 
 
 def main():
@@ -269,6 +290,8 @@ def main():
                         help='reports quad-precision numbers')
     parser.add_argument('-z', '--zipped', action='store_true',
                         help='processes gzipped traces')
+    parser.add_argument('-c', '--cache', type=str,
+                        help='decode cache file, reused and extended across runs')
 
     args = parser.parse_args()
 
@@ -276,6 +299,7 @@ def main():
     global flops_byte_g
     global flops_byte_inv
     global mc
+    global cache
     # We compute FLOP/Byte assuming a constant number of lanes across all combinations
     # up until double or quad precision if requested.
     # TODO if predicate is available in the future, update this.
@@ -295,11 +319,10 @@ def main():
     else:
         meminstrace = open(args.meminstrace, 'r')
 
-    # Set the llvm-mc location based on the env var
+    # Set the llvm-mc location based on the env var. It is only needed
+    # for the encodings missing from the decode cache
     mc = os.environ.get('LLVM_MC')
-    if not mc:
-        sys.stderr.write('error: LLVM_MC env variable not set\n')
-        sys.exit(1)
+    cache = DecodeCache(args.cache)
 
     # Read the header lines of the trace file
     traceline = meminstrace.readline()
@@ -318,13 +341,11 @@ def main():
             ins_isMem = int(splitTrace[2])
 
             decline = instr_decoder(ins_opcode=ins_opcode)
-            if 'invalid instruction encoding' in decline:
-                # decline = 'UNKNOWN'
+            if decline is None:  # Invalid instruction encoding
+                # Its memory accesses have no destination register
+                decline = 'UNKNOWN\t'
                 traceline = meminstrace.readline()
                 continue
-            else:
-                decline = decline.split('\t.text\n', 1)[
-                    1].split('\n')[:-1][0].strip()
 
             if not ins_isMem:
                 # If float instruction, increment #FLOPs
@@ -405,6 +426,8 @@ def main():
 
         traceline = meminstrace.readline()
 
+    cache.save()
+
     # Average FLOPs/Byte
     print("\n====\n Floating Point Operations per Byte loaded \n====\n")
     num_el = args.veclen / 8
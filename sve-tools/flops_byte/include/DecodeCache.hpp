@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DECODE_CACHE_HPP
+#define DECODE_CACHE_HPP
+
+#include "Decoder.hpp"
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+/*
+ * Decoded instructions, keyed by encoding
+ *
+ * Looks an encoding up in memory first, then in the built-in tables and
+ * finally, if a path to llvm-mc is given, disassembles it with llvm-mc.
+ * Results can be kept in a memo file to be reused by later runs, by the
+ * native tools and by the Python tools (decode_cache.py) alike. One entry
+ * per line:
+ *     0x<encoding>\t<mnemonic>\t<operands>
+ * with an empty mnemonic for encodings llvm-mc rejects. Lines starting with
+ * '#' are comments. Encodings that could not be decoded are not saved,
+ * including the ones llvm-mc failed on (e.g. a wrong path): only an explicit
+ * "invalid instruction encoding" makes an entry invalid.
+ */
+class DecodeCache {
+  public:
+    enum decodeStatus { DECODED, INVALID, UNKNOWN };
+
+  private:
+    struct entry {
+        bool valid;
+        std::string mnemonic;
+        std::string operands;
+    };
+
+    Decoder decoder;
+    std::string llvmMc;
+    std::unordered_map<unsigned int, entry> entries;
+    std::vector<unsigned int> added;
+    unsigned int loaded;
+    unsigned int llvmFailures;
+    std::string llvmError;
+
+    decodeStatus llvmDecode(unsigned int encoding, std::string &mnemonic, std::string &operands);
+
+  public:
+    DecodeCache(const std::string &llvmMc);
+
+    // A missing file is an empty cache. Returns false if the file cannot be read
+    bool load(const std::string &fileName);
+    // Appends the entries decoded since the last load or save
+    bool save(const std::string &fileName);
+
+    decodeStatus decode(unsigned int encoding, std::string &mnemonic, std::string &operands);
+
+    unsigned int getLoaded();
+    unsigned int getAdded();
+    // Encodings llvm-mc could not be run on, and its output for the first one
+    unsigned int getLlvmFailures();
+    std::string getLlvmError();
+};
+
+#endif
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef DECODER_HPP
+#define DECODER_HPP
+
+#include <string>
+#include <vector>
+
+/*
+ * Table-driven AArch64 + SVE disassembler
+ *
+ * Covers the encodings the FLOPs/byte accounting looks at: SVE floating-point
+ * arithmetic, SVE, scalar and Advanced SIMD structure loads and stores, scalar
+ * floating-point and the Advanced SIMD instructions with scalar or
+ * general-purpose register operands.
+ * The output follows the syntax of `llvm-mc -disassemble -mattr=+sve`, so that
+ * both can be used interchangeably. Patterns are tried in order and the first
+ * match wins; a pattern without mnemonic marks encodings left undecoded.
+ */
+class Decoder {
+    struct Pattern {
+        unsigned int mask;
+        unsigned int value;
+        std::string mnemonic;
+        std::string operands;
+    };
+
+    std::vector<Pattern> patterns;
+
+    void add(unsigned int mask, unsigned int value, const std::string &mnemonic, const std::string &operands);
+    void addSve();
+    void addSveLoads();
+    void addScalarLoads();
+    void addAdvSimdLoads();
+    void addScalarFp();
+    void addAdvSimd();
+
+  public:
+    Decoder();
+
+    // Returns false if the encoding is not covered by the tables
+    bool decode(unsigned int encoding, std::string &mnemonic, std::string &operands) const;
+};
+
+#endif
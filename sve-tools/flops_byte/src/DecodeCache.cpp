@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DecodeCache.hpp"
+
+#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+DecodeCache::DecodeCache(const std::string &llvmMc) : llvmMc(llvmMc), loaded(0), llvmFailures(0) {
+}
+
+// Disassemble a single encoding with llvm-mc. UNKNOWN if llvm-mc could not be run or its output is not understood
+DecodeCache::decodeStatus DecodeCache::llvmDecode(unsigned int encoding, std::string &mnemonic, std::string &operands) {
+    char command[64];
+    snprintf(command, sizeof(command), "echo \"0x%02x 0x%02x 0x%02x 0x%02x\" | ", encoding & 0xFF,
+             (encoding >> 8) & 0xFF, (encoding >> 16) & 0xFF, encoding >> 24);
+    std::string cmd = std::string(command) + llvmMc + " -disassemble -triple=aarch64 -mattr=+sve 2>&1";
+
+    FILE *pipe = popen(cmd.c_str(), "r");
+    if ( pipe == NULL ) {
+        if ( llvmFailures++ == 0 ) {
+            llvmError = "cannot run " + llvmMc;
+        }
+        return UNKNOWN;
+    }
+    std::string output;
+    char buffer[256];
+    while ( fgets(buffer, sizeof(buffer), pipe) != NULL ) {
+        output += buffer;
+    }
+    int status = pclose(pipe);
+
+    if ( output.find("invalid instruction encoding") != std::string::npos ) {
+        return INVALID;
+    }
+    size_t text = output.find("\t.text\n");
+    if ( status != 0 || text == std::string::npos || output.find('\n', text + 7) == std::string::npos ) {
+        if ( llvmFailures++ == 0 ) {
+            llvmError = output.substr(0, output.find('\n'));
+        }
+        return UNKNOWN;
+    }
+    std::string line = output.substr(text + 7, output.find('\n', text + 7) - text - 7);
+    size_t start = line.find_first_not_of(" \t");
+    size_t tab = line.find('\t', start);
+    mnemonic = line.substr(start, tab - start);
+    operands = tab == std::string::npos ? std::string() : line.substr(tab + 1);
+    operands = operands.substr(0, operands.find_last_not_of(" \t\r") + 1);
+    return DECODED;
+}
+
+bool DecodeCache::load(const std::string &fileName) {
+    if ( access(fileName.c_str(), F_OK) == -1 ) {
+        return true;
+    }
+    std::ifstream file(fileName);
+    if ( !file.is_open() ) {
+        return false;
+    }
+    std::string line;
+    while ( std::getline(file, line) ) {
+        if ( line.empty() || line[0] == '#' ) {
+            continue;
+        }
+        size_t first = line.find('\t');
+        size_t second = first == std::string::npos ? std::string::npos : line.find('\t', first + 1);
+        if ( second == std::string::npos ) {
+            continue;
+        }
+        entry &e = entries[std::strtoul(line.c_str(), NULL, 16)];
+        e.mnemonic = line.substr(first + 1, second - first - 1);
+        e.operands = line.substr(second + 1);
+        e.valid = !e.mnemonic.empty();
+    }
+    loaded = entries.size();
+    added.clear();
+    return true;
+}
+
+bool DecodeCache::save(const std::string &fileName) {
+    bool exists = access(fileName.c_str(), F_OK) != -1;
+    std::ofstream file(fileName, std::ios_base::app);
+    if ( !file.is_open() ) {
+        return false;
+    }
+    if ( !exists ) {
+        file << "# Decoded instructions: 0x<encoding>\\t<mnemonic>\\t<operands>" << std::endl;
+    }
+    char key[16];
+    for ( unsigned int i = 0; i < added.size(); i++ ) {
+        const entry &e = entries[added[i]];
+        snprintf(key, sizeof(key), "0x%08x", added[i]);
+        file << key << "\t" << e.mnemonic << "\t" << e.operands << "\n";
+    }
+    added.clear();
+    return file.good();
+}
+
+DecodeCache::decodeStatus DecodeCache::decode(unsigned int encoding, std::string &mnemonic, std::string &operands) {
+    std::unordered_map<unsigned int, entry>::const_iterator it = entries.find(encoding);
+    if ( it == entries.end() ) {
+        entry e;
+        e.valid = true;
+        if ( !decoder.decode(encoding, e.mnemonic, e.operands) ) {
+            if ( llvmMc.empty() ) {
+                return UNKNOWN;
+            }
+            decodeStatus status = llvmDecode(encoding, e.mnemonic, e.operands);
+            if ( status == UNKNOWN ) {
+                return UNKNOWN;
+            }
+            e.valid = status == DECODED;
+            if ( !e.valid ) {
+                e.mnemonic.clear();
+                e.operands.clear();
+            }
+        }
+        it = entries.insert(std::make_pair(encoding, e)).first;
+        added.push_back(encoding);
+    }
+    if ( !it->second.valid ) {
+        return INVALID;
+    }
+    mnemonic = it->second.mnemonic;
+    operands = it->second.operands;
+    return DECODED;
+}
+
+unsigned int DecodeCache::getLoaded() {
+    return loaded;
+}
+
+unsigned int DecodeCache::getAdded() {
+    return added.size();
+}
+
+unsigned int DecodeCache::getLlvmFailures() {
+    return llvmFailures;
+}
+
+std::string DecodeCache::getLlvmError() {
+    return llvmError;
+}
@@ -0,0 +1,930 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Decoder.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+
+/*
+ * Operand templates are plain text with placeholders between angle brackets:
+ *   <z:lo> <v:lo> <b:lo> <h:lo> <s:lo> <d:lo> <q:lo>   5-bit register fields
+ *   <x:lo> <w:lo>            general-purpose registers, 31 is xzr/wzr
+ *   <X:lo> <W:lo>            general-purpose registers, 31 is sp/wsp
+ *   <R:lo>                   w or x register depending on bit 31
+ *   <p:lo> <P:lo>            3-bit and 4-bit predicate registers
+ *   <z3:lo> <z4:lo>          3-bit and 4-bit vector registers (indexed forms)
+ *   <zl:lo:k> <vn:lo:k>      k-th register of a list, wrapping around z31/v31
+ *   <V:lo> <F:lo> <S:lo> <Sf:lo>  scalar FP/SIMD register sized by the SVE size,
+ *                            the FP type, the SIMD size and the FP sz bit
+ *   <T> <A> <Af> <A8> <Al>   SVE element size and Advanced SIMD arrangements
+ *   <n:hi:lo:mul> <i:hi:lo:mul>  unsigned/signed field times mul
+ *   <ofs:hi:lo:mul> <sofs:hi:lo:mul> <vl:hi:lo:mul>  ", #imm" (and ", mul vl")
+ *                            address offsets, omitted when zero
+ *   <rsh:hi:lo:base>         base minus the field (right shifts, fixed-point bits)
+ *   <fp8:lo> <cond:lo> <xs:bit> <rext:shift>  FP immediate, condition,
+ *                            SVE offset extension, register offset extension
+ *   <hl> <i3h> <e5> <i5> <i4> <Q5> <G5> <ls:shift>  element index and size helpers
+ * A placeholder that does not apply to the encoding makes it undecoded.
+ */
+
+static unsigned int field(unsigned int e, unsigned int hi, unsigned int lo) {
+    return (e >> lo) & ((1U << (hi - lo + 1)) - 1);
+}
+
+static int signedField(unsigned int e, unsigned int hi, unsigned int lo) {
+    unsigned int width = hi - lo + 1;
+    int value = field(e, hi, lo);
+    if ( value & (1 << (width - 1)) ) {
+        value -= 1 << width;
+    }
+    return value;
+}
+
+static std::string number(long value) {
+    return std::to_string(value);
+}
+
+static std::string reg(const char *prefix, unsigned int n) {
+    return prefix + number(n);
+}
+
+static const char *SVE_SIZES = "bhsd";
+
+static const char *CONDITIONS[16] = {
+    "eq", "ne", "hs", "lo", "mi", "pl", "vs", "vc",
+    "hi", "ls", "ge", "lt", "gt", "le", "al", "nv"
+};
+
+// VFPExpandImm, printed the way llvm-mc does
+static std::string fpImmediate(unsigned int imm8) {
+    int exponent = (imm8 & 0x40) ? (int) ((imm8 >> 4) & 0x3) - 3 : (int) ((imm8 >> 4) & 0x3) + 1;
+    double value = (16.0 + (imm8 & 0xF)) / 16.0 * std::ldexp(1.0, exponent);
+    if ( imm8 & 0x80 ) {
+        value = -value;
+    }
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "#%.8f", value);
+    return buffer;
+}
+
+// Lowest set bit of imm5 gives the element size of the Advanced SIMD copy instructions
+static int copySize(unsigned int e) {
+    unsigned int imm5 = field(e, 20, 16);
+    for ( int size = 0; size < 4; size++ ) {
+        if ( imm5 & (1U << size) ) {
+            return size;
+        }
+    }
+    return -1;
+}
+
+static bool expand(unsigned int e, const std::string &spec, std::string &out) {
+    std::string name;
+    unsigned int args[3] = { 0, 0, 1 };
+    unsigned int numArgs = 0;
+    size_t colon = spec.find(':');
+    name = spec.substr(0, colon);
+    while ( colon != std::string::npos && numArgs < 3 ) {
+        size_t next = spec.find(':', colon + 1);
+        args[numArgs++] = std::stoul(spec.substr(colon + 1, next - colon - 1));
+        colon = next;
+    }
+    unsigned int lo = args[0];
+    unsigned int r = (numArgs >= 1 && lo < 28) ? field(e, lo + 4, lo) : 0;
+    unsigned int sveSize = field(e, 23, 22);
+
+    if ( name == "z" || name == "v" || name == "b" || name == "h" || name == "s" || name == "d" || name == "q" ) {
+        out += reg(name.c_str(), r);
+    } else if ( name == "x" || name == "w" ) {
+        out += (r == 31) ? name + "zr" : reg(name.c_str(), r);
+    } else if ( name == "X" ) {
+        out += (r == 31) ? "sp" : reg("x", r);
+    } else if ( name == "W" ) {
+        out += (r == 31) ? "wsp" : reg("w", r);
+    } else if ( name == "R" ) {
+        const char *prefix = field(e, 31, 31) ? "x" : "w";
+        out += (r == 31) ? std::string(prefix) + "zr" : reg(prefix, r);
+    } else if ( name == "p" ) {
+        out += reg("p", field(e, lo + 2, lo));
+    } else if ( name == "P" ) {
+        out += reg("p", field(e, lo + 3, lo));
+    } else if ( name == "z3" ) {
+        out += reg("z", field(e, lo + 2, lo));
+    } else if ( name == "z4" ) {
+        out += reg("z", field(e, lo + 3, lo));
+    } else if ( name == "zl" ) {
+        out += reg("z", (r + args[1]) % 32);
+    } else if ( name == "vn" ) {
+        out += reg("v", (r + args[1]) % 32);
+    } else if ( name == "V" ) {
+        out += std::string(1, SVE_SIZES[sveSize]) + number(r);
+    } else if ( name == "F" ) {
+        static const char *types[4] = { "s", "d", NULL, "h" };
+        if ( types[sveSize] == NULL ) {
+            return false;
+        }
+        out += reg(types[sveSize], r);
+    } else if ( name == "S" ) {
+        out += std::string(1, SVE_SIZES[sveSize]) + number(r);
+    } else if ( name == "Sf" ) {
+        out += reg(field(e, 22, 22) ? "d" : "s", r);
+    } else if ( name == "T" ) {
+        out += SVE_SIZES[sveSize];
+    } else if ( name == "A" ) {
+        static const char *arrangements[8] = { "8b", "16b", "4h", "8h", "2s", "4s", NULL, "2d" };
+        const char *arrangement = arrangements[sveSize * 2 + field(e, 30, 30)];
+        if ( arrangement == NULL ) {
+            return false;
+        }
+        out += arrangement;
+    } else if ( name == "Af" ) {
+        static const char *arrangements[4] = { "2s", "4s", NULL, "2d" };
+        const char *arrangement = arrangements[field(e, 22, 22) * 2 + field(e, 30, 30)];
+        if ( arrangement == NULL ) {
+            return false;
+        }
+        out += arrangement;
+    } else if ( name == "Al" ) {
+        // Arrangement of the structure loads and stores, sized by bits 11:10
+        static const char *arrangements[8] = { "8b", "16b", "4h", "8h", "2s", "4s", "1d", "2d" };
+        out += arrangements[field(e, 11, 10) * 2 + field(e, 30, 30)];
+    } else if ( name == "A8" ) {
+        out += field(e, 30, 30) ? "16b" : "8b";
+    } else if ( name == "n" ) {
+        out += number(field(e, args[0], args[1]) * (long) args[2]);
+    } else if ( name == "i" ) {
+        out += number(signedField(e, args[0], args[1]) * (long) args[2]);
+    } else if ( name == "ofs" ) {
+        unsigned long value = field(e, args[0], args[1]) * (unsigned long) args[2];
+        if ( value != 0 ) {
+            out += ", #" + number(value);
+        }
+    } else if ( name == "sofs" || name == "vl" ) {
+        long value = signedField(e, args[0], args[1]) * (long) args[2];
+        if ( value != 0 ) {
+            out += ", #" + number(value) + (name == "vl" ? ", mul vl" : "");
+        }
+    } else if ( name == "rsh" ) {
+        out += number((long) args[2] - field(e, args[0], args[1]));
+    } else if ( name == "fp8" ) {
+        out += fpImmediate(field(e, lo + 7, lo));
+    } else if ( name == "cond" ) {
+        out += CONDITIONS[field(e, lo + 3, lo)];
+    } else if ( name == "xs" ) {
+        out += field(e, lo, lo) ? "sxtw" : "uxtw";
+    } else if ( name == "rext" ) {
+        // Register offset of the scalar loads and stores: option (15:13), S (12), Rm (20:16)
+        unsigned int option = field(e, 15, 13);
+        unsigned int rm = field(e, 20, 16);
+        bool shifted = field(e, 12, 12);
+        std::string amount = shifted ? " #" + number(lo) : "";
+        switch ( option ) {
+            case 2: out += (rm == 31 ? "wzr" : reg("w", rm)) + ", uxtw" + amount; break;
+            case 3: out += (rm == 31 ? "xzr" : reg("x", rm)) + (shifted ? ", lsl" + amount : ""); break;
+            case 6: out += (rm == 31 ? "wzr" : reg("w", rm)) + ", sxtw" + amount; break;
+            case 7: out += (rm == 31 ? "xzr" : reg("x", rm)) + ", sxtx" + amount; break;
+            default: return false;
+        }
+    } else if ( name == "hl" ) {
+        out += number(field(e, 11, 11) * 2 + field(e, 21, 21));
+    } else if ( name == "i3h" ) {
+        out += number(field(e, 22, 22) * 4 + field(e, 20, 19));
+    } else if ( name == "e5" ) {
+        int size = copySize(e);
+        if ( size < 0 ) {
+            return false;
+        }
+        out += SVE_SIZES[size];
+    } else if ( name == "i5" ) {
+        int size = copySize(e);
+        if ( size < 0 ) {
+            return false;
+        }
+        out += number(field(e, 20, 16) >> (size + 1));
+    } else if ( name == "i4" ) {
+        int size = copySize(e);
+        if ( size < 0 ) {
+            return false;
+        }
+        // The bits below the element size must be zero
+        if ( field(e, 14, 11) & ((1U << size) - 1) ) {
+            return false;
+        }
+        out += number(field(e, 14, 11) >> size);
+    } else if ( name == "Q5" ) {
+        // Arrangement of DUP, a 64-bit element needs the full vector
+        static const char *arrangements[8] = { "8b", "16b", "4h", "8h", "2s", "4s", NULL, "2d" };
+        int size = copySize(e);
+        if ( size < 0 || arrangements[size * 2 + field(e, 30, 30)] == NULL ) {
+            return false;
+        }
+        out += arrangements[size * 2 + field(e, 30, 30)];
+    } else if ( name == "G5" ) {
+        // General-purpose register of DUP/INS, x only for 64-bit elements.
+        // <G5:lo:1> requires the unused index bits of DUP to be zero
+        int size = copySize(e);
+        if ( size < 0 || (numArgs > 1 && args[1] && (field(e, 20, 16) >> (size + 1)) != 0) ) {
+            return false;
+        }
+        const char *prefix = (size == 3) ? "x" : "w";
+        out += (r == 31) ? std::string(prefix) + "zr" : reg(prefix, r);
+    } else if ( name == "ls" ) {
+        // Lane of the single structure loads and stores: Q:S:size, scaled by the element size
+        out += number((field(e, 30, 30) << 3 | field(e, 12, 12) << 2 | field(e, 11, 10)) >> lo);
+    } else {
+        return false;
+    }
+    return true;
+}
+
+static bool format(unsigned int e, const std::string &operands, std::string &out) {
+    out.clear();
+    size_t i = 0;
+    while ( i < operands.size() ) {
+        if ( operands[i] == '<' ) {
+            size_t end = operands.find('>', i);
+            if ( !expand(e, operands.substr(i + 1, end - i - 1), out) ) {
+                return false;
+            }
+            i = end + 1;
+        } else {
+            out += operands[i++];
+        }
+    }
+    return true;
+}
+
+/*
+ * Pattern tables
+ */
+void Decoder::add(unsigned int mask, unsigned int value, const std::string &mnemonic, const std::string &operands) {
+    patterns.push_back(Pattern{ mask, value, mnemonic, operands });
+}
+
+void Decoder::addSve() {
+    // No floating-point operation works on bytes
+    add(0xFFC00000, 0x65000000, "", "");
+
+    // Predicated arithmetic
+    static const char *arith[16] = { "fadd", "fsub", "fmul", "fsubr", "fmaxnm", "fminnm", "fmax", "fmin",
+                                     "fabd", "fscale", "fmulx", NULL, "fdivr", "fdiv", NULL, NULL };
+    for ( unsigned int opc = 0; opc < 16; opc++ ) {
+        if ( arith[opc] ) {
+            add(0xFF3FE000, 0x65008000 | opc << 16, arith[opc], "<z:0>.<T>, <p:10>/m, <z:0>.<T>, <z:5>.<T>");
+        }
+    }
+    // Predicated arithmetic with a one-bit immediate
+    static const char *arithImm[8] = { "fadd", "fsub", "fmul", "fsubr", "fmaxnm", "fminnm", "fmax", "fmin" };
+    static const char *immediates[8][2] = { { "0.5", "1.0" }, { "0.5", "1.0" }, { "0.5", "2.0" }, { "0.5", "1.0" },
+                                            { "0.0", "1.0" }, { "0.0", "1.0" }, { "0.0", "1.0" }, { "0.0", "1.0" } };
+    for ( unsigned int opc = 0; opc < 8; opc++ ) {
+        for ( unsigned int i1 = 0; i1 < 2; i1++ ) {
+            add(0xFF3FE3E0, 0x65188000 | opc << 16 | i1 << 5, arithImm[opc],
+                std::string("<z:0>.<T>, <p:10>/m, <z:0>.<T>, #") + immediates[opc][i1]);
+        }
+    }
+    add(0xFF38FC00, 0x65108000, "ftmad", "<z:0>.<T>, <z:0>.<T>, <z:5>.<T>, #<n:18:16:1>");
+
+    // Unpredicated arithmetic
+    static const char *unpredicated[8] = { "fadd", "fsub", "fmul", "ftsmul", NULL, NULL, "frecps", "frsqrts" };
+    for ( unsigned int opc = 0; opc < 8; opc++ ) {
+        if ( unpredicated[opc] ) {
+            add(0xFF20FC00, 0x65000000 | opc << 10, unpredicated[opc], "<z:0>.<T>, <z:5>.<T>, <z:16>.<T>");
+        }
+    }
+    add(0xFF3FFC00, 0x650E3000, "frecpe", "<z:0>.<T>, <z:5>.<T>");
+    add(0xFF3FFC00, 0x650F3000, "frsqrte", "<z:0>.<T>, <z:5>.<T>");
+
+    // Reductions
+    static const char *reductions[8] = { "faddv", NULL, NULL, NULL, "fmaxnmv", "fminnmv", "fmaxv", "fminv" };
+    for ( unsigned int opc = 0; opc < 8; opc++ ) {
+        if ( reductions[opc] ) {
+            add(0xFF3FE000, 0x65002000 | opc << 16, reductions[opc], "<V:0>, <p:10>, <z:5>.<T>");
+        }
+    }
+    add(0xFF3FE000, 0x65182000, "fadda", "<V:0>, <p:10>, <V:0>, <z:5>.<T>");
+
+    // Compares
+    static const struct { unsigned int bits; const char *mnemonic; } zeroCompares[6] = {
+        { 0x00000, "fcmge" }, { 0x00010, "fcmgt" }, { 0x10000, "fcmlt" },
+        { 0x10010, "fcmle" }, { 0x20000, "fcmeq" }, { 0x30000, "fcmne" }
+    };
+    for ( unsigned int i = 0; i < 6; i++ ) {
+        add(0xFF3FE010, 0x65102000 | zeroCompares[i].bits, zeroCompares[i].mnemonic,
+            "<P:0>.<T>, <p:10>/z, <z:5>.<T>, #0.0");
+    }
+    static const char *compares[8] = { "fcmge", "fcmgt", "fcmeq", "fcmne", "fcmuo", "facge", NULL, "facgt" };
+    for ( unsigned int op = 0; op < 8; op++ ) {
+        if ( compares[op] ) {
+            add(0xFF20E010, 0x65004000 | (op >> 2) << 15 | ((op >> 1) & 1) << 13 | (op & 1) << 4, compares[op],
+                "<P:0>.<T>, <p:10>/z, <z:5>.<T>, <z:16>.<T>");
+        }
+    }
+
+    // Multiply-add
+    static const char *fmla[4] = { "fmla", "fmls", "fnmla", "fnmls" };
+    static const char *fmad[4] = { "fmad", "fmsb", "fnmad", "fnmsb" };
+    for ( unsigned int opc = 0; opc < 4; opc++ ) {
+        add(0xFF20E000, 0x65200000 | opc << 13, fmla[opc], "<z:0>.<T>, <p:10>/m, <z:5>.<T>, <z:16>.<T>");
+        add(0xFF20E000, 0x65208000 | opc << 13, fmad[opc], "<z:0>.<T>, <p:10>/m, <z:5>.<T>, <z:16>.<T>");
+    }
+
+    // Unary operations
+    static const char *rounding[8] = { "frintn", "frintp", "frintm", "frintz", "frinta", NULL, "frintx", "frinti" };
+    for ( unsigned int opc = 0; opc < 8; opc++ ) {
+        if ( rounding[opc] ) {
+            add(0xFF3FE000, 0x6500A000 | opc << 16, rounding[opc], "<z:0>.<T>, <p:10>/m, <z:5>.<T>");
+        }
+    }
+    add(0xFF3FE000, 0x650CA000, "frecpx", "<z:0>.<T>, <p:10>/m, <z:5>.<T>");
+    add(0xFF3FE000, 0x650DA000, "fsqrt", "<z:0>.<T>, <p:10>/m, <z:5>.<T>");
+
+    // Conversions, the sizes are part of the opcode
+    static const struct { unsigned int value; const char *mnemonic; const char *to; const char *from; } conversions[] = {
+        { 0x6588A000, "fcvt", "h", "s" }, { 0x6589A000, "fcvt", "s", "h" },
+        { 0x65C8A000, "fcvt", "h", "d" }, { 0x65C9A000, "fcvt", "d", "h" },
+        { 0x65CAA000, "fcvt", "s", "d" }, { 0x65CBA000, "fcvt", "d", "s" },
+        { 0x6552A000, "scvtf", "h", "h" }, { 0x6553A000, "ucvtf", "h", "h" },
+        { 0x6554A000, "scvtf", "h", "s" }, { 0x6555A000, "ucvtf", "h", "s" },
+        { 0x6556A000, "scvtf", "h", "d" }, { 0x6557A000, "ucvtf", "h", "d" },
+        { 0x6594A000, "scvtf", "s", "s" }, { 0x6595A000, "ucvtf", "s", "s" },
+        { 0x65D0A000, "scvtf", "d", "s" }, { 0x65D1A000, "ucvtf", "d", "s" },
+        { 0x65D4A000, "scvtf", "s", "d" }, { 0x65D5A000, "ucvtf", "s", "d" },
+        { 0x65D6A000, "scvtf", "d", "d" }, { 0x65D7A000, "ucvtf", "d", "d" },
+        { 0x655AA000, "fcvtzs", "h", "h" }, { 0x655BA000, "fcvtzu", "h", "h" },
+        { 0x655CA000, "fcvtzs", "s", "h" }, { 0x655DA000, "fcvtzu", "s", "h" },
+        { 0x655EA000, "fcvtzs", "d", "h" }, { 0x655FA000, "fcvtzu", "d", "h" },
+        { 0x659CA000, "fcvtzs", "s", "s" }, { 0x659DA000, "fcvtzu", "s", "s" },
+        { 0x65D8A000, "fcvtzs", "s", "d" }, { 0x65D9A000, "fcvtzu", "s", "d" },
+        { 0x65DCA000, "fcvtzs", "d", "s" }, { 0x65DDA000, "fcvtzu", "d", "s" },
+        { 0x65DEA000, "fcvtzs", "d", "d" }, { 0x65DFA000, "fcvtzu", "d", "d" },
+    };
+    for ( unsigned int i = 0; i < sizeof(conversions) / sizeof(conversions[0]); i++ ) {
+        add(0xFFFFE000, conversions[i].value, conversions[i].mnemonic,
+            std::string("<z:0>.") + conversions[i].to + ", <p:10>/m, <z:5>." + conversions[i].from);
+    }
+
+    // Complex arithmetic
+    add(0xFFE08000, 0x64000000, "", "");
+    add(0xFF208000, 0x64000000, "fcmla", "<z:0>.<T>, <p:10>/m, <z:5>.<T>, <z:16>.<T>, #<n:14:13:90>");
+    add(0xFFFEE000, 0x64008000, "", "");
+    add(0xFF3FE000, 0x64008000, "fcadd", "<z:0>.<T>, <p:10>/m, <z:0>.<T>, <z:5>.<T>, #90");
+    add(0xFF3FE000, 0x64018000, "fcadd", "<z:0>.<T>, <p:10>/m, <z:0>.<T>, <z:5>.<T>, #270");
+
+    add(0xFFE0F000, 0x64A01000, "fcmla", "<z:0>.h, <z:5>.h, <z3:16>.h[<n:20:19:1>], #<n:11:10:90>");
+    add(0xFFE0F000, 0x64E01000, "fcmla", "<z:0>.s, <z:5>.s, <z4:16>.s[<n:20:20:1>], #<n:11:10:90>");
+
+    // Indexed multiply and multiply-add
+    static const char *indexed[3] = { "fmla", "fmls", "fmul" };
+    static const unsigned int indexedOps[3] = { 0x0000, 0x0400, 0x2000 };
+    for ( unsigned int i = 0; i < 3; i++ ) {
+        add(0xFFA0FC00, 0x64200000 | indexedOps[i], indexed[i], "<z:0>.h, <z:5>.h, <z3:16>.h[<i3h>]");
+        add(0xFFE0FC00, 0x64A00000 | indexedOps[i], indexed[i], "<z:0>.s, <z:5>.s, <z3:16>.s[<n:20:19:1>]");
+        add(0xFFE0FC00, 0x64E00000 | indexedOps[i], indexed[i], "<z:0>.d, <z:5>.d, <z4:16>.d[<n:20:20:1>]");
+    }
+}
+
+void Decoder::addSveLoads() {
+    // Contiguous loads, indexed by dtype: mnemonic suffix, element size and log2 of the memory size
+    static const struct { const char *suffix; const char *element; unsigned int msz; } dtypes[16] = {
+        { "b", "b", 0 }, { "b", "h", 0 }, { "b", "s", 0 }, { "b", "d", 0 },
+        { "sw", "d", 2 }, { "h", "h", 1 }, { "h", "s", 1 }, { "h", "d", 1 },
+        { "sh", "d", 1 }, { "sh", "s", 1 }, { "w", "s", 2 }, { "w", "d", 2 },
+        { "sb", "d", 0 }, { "sb", "s", 0 }, { "sb", "h", 0 }, { "d", "d", 3 }
+    };
+    static const char *sizes[4] = { "b", "h", "w", "d" };
+
+    // Scalar plus scalar forms need a register offset, xzr is only valid for first-faulting loads
+    add(0xFE1FE000, 0xA41F4000, "", "");
+    add(0xFE1FE000, 0xA41F0000, "", "");
+    add(0xFE1FE000, 0xA41FC000, "", "");
+    add(0xFE1FE000, 0xE41F4000, "", "");
+
+    for ( unsigned int dtype = 0; dtype < 16; dtype++ ) {
+        std::string list = std::string("{ <z:0>.") + dtypes[dtype].element + " }, <p:10>/z, ";
+        std::string offset = dtypes[dtype].msz ? ", lsl #" + number(dtypes[dtype].msz) : "";
+        add(0xFFE0E000, 0xA4004000 | dtype << 21, std::string("ld1") + dtypes[dtype].suffix,
+            list + "[<X:5>, <x:16>" + offset + "]");
+        add(0xFFFFE000, 0xA41F6000 | dtype << 21, std::string("ldff1") + dtypes[dtype].suffix, list + "[<X:5>]");
+        add(0xFFE0E000, 0xA4006000 | dtype << 21, std::string("ldff1") + dtypes[dtype].suffix,
+            list + "[<X:5>, <x:16>" + offset + "]");
+        add(0xFFF0E000, 0xA400A000 | dtype << 21, std::string("ld1") + dtypes[dtype].suffix,
+            list + "[<X:5><vl:19:16:1>]");
+        add(0xFFF0E000, 0xA410A000 | dtype << 21, std::string("ldnf1") + dtypes[dtype].suffix,
+            list + "[<X:5><vl:19:16:1>]");
+        // Broadcasts scale the offset by the memory size
+        add(0xFFC0E000, 0x84408000 | (dtype >> 2) << 23 | (dtype & 3) << 13,
+            std::string("ld1r") + dtypes[dtype].suffix,
+            list + "[<X:5><ofs:21:16:" + number(1 << dtypes[dtype].msz) + ">]");
+    }
+
+    for ( unsigned int msz = 0; msz < 4; msz++ ) {
+        std::string element = std::string(1, SVE_SIZES[msz]);
+        std::string offset = msz ? ", lsl #" + number(msz) : "";
+        add(0xFFE0E000, 0xA4000000 | msz << 23, std::string("ld1rq") + sizes[msz],
+            "{ <z:0>." + element + " }, <p:10>/z, [<X:5>, <x:16>" + offset + "]");
+        add(0xFFF0E000, 0xA4002000 | msz << 23, std::string("ld1rq") + sizes[msz],
+            "{ <z:0>." + element + " }, <p:10>/z, [<X:5><sofs:19:16:16>]");
+        // Multi-register structures, num 0 is the non-temporal load
+        for ( unsigned int num = 0; num < 4; num++ ) {
+            std::string mnemonic = num ? "ld" + number(num + 1) + sizes[msz] : std::string("ldnt1") + sizes[msz];
+            std::string list = "{ ";
+            for ( unsigned int k = 0; k <= num; k++ ) {
+                list += (k ? ", <zl:0:" : "<zl:0:") + number(k) + ">." + element;
+            }
+            list += " }, <p:10>/z, ";
+            add(0xFFE0E000, 0xA400C000 | msz << 23 | num << 21, mnemonic, list + "[<X:5>, <x:16>" + offset + "]");
+            add(0xFFF0E000, 0xA400E000 | msz << 23 | num << 21, mnemonic,
+                list + "[<X:5><vl:19:16:" + number(num + 1) + ">]");
+        }
+        // Contiguous stores, the element may be wider than the memory size
+        for ( unsigned int size = msz; size < 4; size++ ) {
+            std::string list = std::string("{ <z:0>.") + SVE_SIZES[size] + " }, <p:10>, ";
+            add(0xFFE0E000, 0xE4004000 | msz << 23 | size << 21, std::string("st1") + sizes[msz],
+                list + "[<X:5>, <x:16>" + offset + "]");
+            add(0xFFF0E000, 0xE400E000 | msz << 23 | size << 21, std::string("st1") + sizes[msz],
+                list + "[<X:5><vl:19:16:1>]");
+        }
+    }
+
+    // Gathers, 'U' selects the zero-extending loads and 'ff' the first-faulting ones
+    static const char *gathers[2][4] = { { "sb", "sh", "sw", NULL }, { "b", "h", "w", "d" } };
+    for ( unsigned int msz = 0; msz < 4; msz++ ) {
+        for ( unsigned int u = 0; u < 2; u++ ) {
+            if ( gathers[u][msz] == NULL ) {
+                continue;
+            }
+            for ( unsigned int ff = 0; ff < 2; ff++ ) {
+                std::string mnemonic = std::string(ff ? "ldff1" : "ld1") + gathers[u][msz];
+                unsigned int bits = msz << 23 | u << 14 | ff << 13;
+                std::string scale = " #" + number(msz);
+                std::string immediate = "<ofs:20:16:" + number(1 << msz) + ">";
+                // 64-bit elements
+                std::string list = "{ <z:0>.d }, <p:10>/z, ";
+                add(0xFFE0E000, 0xC4208000 | bits, mnemonic, list + "[<z:5>.d" + immediate + "]");
+                add(0xFFE0E000, 0xC4408000 | bits, mnemonic, list + "[<X:5>, <z:16>.d]");
+                add(0xFFA0E000, 0xC4000000 | bits, mnemonic, list + "[<X:5>, <z:16>.d, <xs:22>]");
+                if ( msz > 0 ) {
+                    add(0xFFE0E000, 0xC4608000 | bits, mnemonic, list + "[<X:5>, <z:16>.d, lsl" + scale + "]");
+                    add(0xFFA0E000, 0xC4200000 | bits, mnemonic, list + "[<X:5>, <z:16>.d, <xs:22>" + scale + "]");
+                }
+                // 32-bit elements
+                if ( msz == 3 || (msz == 2 && u == 0) ) {
+                    continue;
+                }
+                list = "{ <z:0>.s }, <p:10>/z, ";
+                add(0xFFE0E000, 0x84208000 | bits, mnemonic, list + "[<z:5>.s" + immediate + "]");
+                add(0xFFA0E000, 0x84000000 | bits, mnemonic, list + "[<X:5>, <z:16>.s, <xs:22>]");
+                if ( msz > 0 ) {
+                    add(0xFFA0E000, 0x84200000 | bits, mnemonic, list + "[<X:5>, <z:16>.s, <xs:22>" + scale + "]");
+                }
+            }
+        }
+    }
+}
+
+void Decoder::addScalarLoads() {
+    // Register, mnemonic and access size for every size:V:opc combination
+    static const struct { unsigned int size; unsigned int v; unsigned int opc; const char *mnemonic; const char *reg; unsigned int shift; } forms[] = {
+        { 0, 0, 0, "strb", "w", 0 }, { 0, 0, 1, "ldrb", "w", 0 }, { 0, 0, 2, "ldrsb", "x", 0 }, { 0, 0, 3, "ldrsb", "w", 0 },
+        { 1, 0, 0, "strh", "w", 1 }, { 1, 0, 1, "ldrh", "w", 1 }, { 1, 0, 2, "ldrsh", "x", 1 }, { 1, 0, 3, "ldrsh", "w", 1 },
+        { 2, 0, 0, "str", "w", 2 }, { 2, 0, 1, "ldr", "w", 2 }, { 2, 0, 2, "ldrsw", "x", 2 },
+        { 3, 0, 0, "str", "x", 3 }, { 3, 0, 1, "ldr", "x", 3 },
+        { 0, 1, 0, "str", "b", 0 }, { 0, 1, 1, "ldr", "b", 0 }, { 0, 1, 2, "str", "q", 4 }, { 0, 1, 3, "ldr", "q", 4 },
+        { 1, 1, 0, "str", "h", 1 }, { 1, 1, 1, "ldr", "h", 1 },
+        { 2, 1, 0, "str", "s", 2 }, { 2, 1, 1, "ldr", "s", 2 },
+        { 3, 1, 0, "str", "d", 3 }, { 3, 1, 1, "ldr", "d", 3 },
+    };
+    for ( unsigned int i = 0; i < sizeof(forms) / sizeof(forms[0]); i++ ) {
+        unsigned int bits = forms[i].size << 30 | forms[i].v << 26 | forms[i].opc << 22;
+        std::string mnemonic = forms[i].mnemonic;
+        std::string rt = std::string("<") + forms[i].reg + ":0>, ";
+        add(0xFFC00000, 0x39000000 | bits, mnemonic, rt + "[<X:5><ofs:21:10:" + number(1 << forms[i].shift) + ">]");
+        add(0xFFE00C00, 0x38000000 | bits, mnemonic.substr(0, 2) + "u" + mnemonic.substr(2), rt + "[<X:5><sofs:20:12:1>]");
+        add(0xFFE00C00, 0x38000400 | bits, mnemonic, rt + "[<X:5>], #<i:20:12:1>");
+        add(0xFFE00C00, 0x38000C00 | bits, mnemonic, rt + "[<X:5>, #<i:20:12:1>]!");
+        if ( forms[i].v == 0 ) {
+            add(0xFFE00C00, 0x38000800 | bits, mnemonic.substr(0, 2) + "t" + mnemonic.substr(2), rt + "[<X:5><sofs:20:12:1>]");
+        }
+        add(0xFFE00C00, 0x38200800 | bits, mnemonic, rt + "[<X:5>, <rext:" + number(forms[i].shift) + ">]");
+    }
+
+    // Pairs: opc:V:L, register and access size. Index 0 is the non-temporal pair
+    static const struct { unsigned int opc; unsigned int v; unsigned int l; const char *mnemonic; const char *reg; unsigned int size; } pairs[] = {
+        { 0, 0, 0, "stp", "w", 4 }, { 0, 0, 1, "ldp", "w", 4 }, { 1, 0, 1, "ldpsw", "x", 4 },
+        { 2, 0, 0, "stp", "x", 8 }, { 2, 0, 1, "ldp", "x", 8 },
+        { 0, 1, 0, "stp", "s", 4 }, { 0, 1, 1, "ldp", "s", 4 }, { 1, 1, 0, "stp", "d", 8 }, { 1, 1, 1, "ldp", "d", 8 },
+        { 2, 1, 0, "stp", "q", 16 }, { 2, 1, 1, "ldp", "q", 16 },
+    };
+    for ( unsigned int i = 0; i < sizeof(pairs) / sizeof(pairs[0]); i++ ) {
+        unsigned int bits = pairs[i].opc << 30 | pairs[i].v << 26 | pairs[i].l << 22;
+        std::string mnemonic = pairs[i].mnemonic;
+        std::string scale = number(pairs[i].size);
+        std::string rt = std::string("<") + pairs[i].reg + ":0>, <" + pairs[i].reg + ":10>, ";
+        if ( mnemonic != "ldpsw" ) {
+            add(0xFFC00000, 0x28000000 | bits, mnemonic.substr(0, 2) + "np", rt + "[<X:5><sofs:21:15:" + scale + ">]");
+        }
+        add(0xFFC00000, 0x28800000 | bits, mnemonic, rt + "[<X:5>], #<i:21:15:" + scale + ">");
+        add(0xFFC00000, 0x29000000 | bits, mnemonic, rt + "[<X:5><sofs:21:15:" + scale + ">]");
+        add(0xFFC00000, 0x29800000 | bits, mnemonic, rt + "[<X:5>, #<i:21:15:" + scale + ">]!");
+    }
+
+    // PC-relative literals
+    static const struct { unsigned int opc; unsigned int v; const char *reg; const char *mnemonic; } literals[] = {
+        { 0, 0, "w", "ldr" }, { 1, 0, "x", "ldr" }, { 2, 0, "x", "ldrsw" },
+        { 0, 1, "s", "ldr" }, { 1, 1, "d", "ldr" }, { 2, 1, "q", "ldr" },
+    };
+    for ( unsigned int i = 0; i < sizeof(literals) / sizeof(literals[0]); i++ ) {
+        add(0xFF000000, 0x18000000 | literals[i].opc << 30 | literals[i].v << 26, literals[i].mnemonic,
+            std::string("<") + literals[i].reg + ":0>, #<i:23:5:4>");
+    }
+
+    // Exclusive and acquire loads, the unused register fields are all ones
+    static const char *byteSizes[4] = { "b", "h", "", "" };
+    for ( unsigned int size = 0; size < 4; size++ ) {
+        std::string rt = size == 3 ? "<x:0>" : "<w:0>";
+        add(0xFFFFFC00, 0x085F7C00 | size << 30, std::string("ldxr") + byteSizes[size], rt + ", [<X:5>]");
+        add(0xFFFFFC00, 0x085FFC00 | size << 30, std::string("ldaxr") + byteSizes[size], rt + ", [<X:5>]");
+        add(0xFFFFFC00, 0x08DFFC00 | size << 30, std::string("ldar") + byteSizes[size], rt + ", [<X:5>]");
+        if ( size >= 2 ) {
+            std::string rt2 = size == 3 ? "<x:10>" : "<w:10>";
+            add(0xFFFF8000, 0x087F0000 | size << 30, "ldxp", rt + ", " + rt2 + ", [<X:5>]");
+            add(0xFFFF8000, 0x087F8000 | size << 30, "ldaxp", rt + ", " + rt2 + ", [<X:5>]");
+        }
+    }
+}
+
+// "{ v0.<T>, v1.<T> }" for the structure loads and stores
+static std::string vectorList(unsigned int count, const std::string &arrangement) {
+    std::string list = "{ ";
+    for ( unsigned int k = 0; k < count; k++ ) {
+        list += (k ? ", <vn:0:" : "<vn:0:") + number(k) + ">." + arrangement;
+    }
+    return list + " }";
+}
+
+void Decoder::addAdvSimdLoads() {
+    static const char *ops[2] = { "st", "ld" };
+
+    // Multiple structures: opcode and number of registers. Structures of 1D elements are reserved
+    static const struct { unsigned int opcode; unsigned int selem; unsigned int regs; } multiple[] = {
+        { 0x0, 4, 4 }, { 0x2, 1, 4 }, { 0x4, 3, 3 }, { 0x6, 1, 3 }, { 0x7, 1, 1 }, { 0x8, 2, 2 }, { 0xA, 1, 2 },
+    };
+    for ( unsigned int i = 0; i < sizeof(multiple) / sizeof(multiple[0]); i++ ) {
+        if ( multiple[i].selem > 1 ) {
+            add(0xFF20FC00, 0x0C000C00 | multiple[i].opcode << 12, "", "");
+        }
+        for ( unsigned int l = 0; l < 2; l++ ) {
+            unsigned int value = 0x0C000000 | l << 22 | multiple[i].opcode << 12;
+            std::string mnemonic = ops[l] + number(multiple[i].selem);
+            std::string list = vectorList(multiple[i].regs, "<Al>");
+            add(0xBFFFF000, value, mnemonic, list + ", [<X:5>]");
+            for ( unsigned int q = 0; q < 2; q++ ) {
+                add(0xFFFFF000, value | q << 30 | 0x009F0000, mnemonic,
+                    list + ", [<X:5>], #" + number(multiple[i].regs * (q ? 16 : 8)));
+            }
+            add(0xBFE0F000, value | 0x00800000, mnemonic, list + ", [<X:5>], <x:16>");
+        }
+    }
+
+    // Single structures: one lane of each register, or replicated to all lanes (loads only)
+    static const struct { unsigned int mask; unsigned int bits; const char *type; unsigned int shift; } lanes[4] = {
+        { 0xBFFFE000, 0x0000, "b", 0 }, { 0xBFFFE400, 0x4000, "h", 1 },
+        { 0xBFFFEC00, 0x8000, "s", 2 }, { 0xBFFFFC00, 0x8400, "d", 3 },
+    };
+    for ( unsigned int selem = 1; selem <= 4; selem++ ) {
+        unsigned int bits = ((selem - 1) & 1) << 21 | ((selem - 1) >> 1) << 13;
+        for ( unsigned int l = 0; l < 2; l++ ) {
+            std::string mnemonic = ops[l] + number(selem);
+            for ( unsigned int t = 0; t < 4; t++ ) {
+                unsigned int value = 0x0D000000 | l << 22 | bits | lanes[t].bits;
+                std::string list = vectorList(selem, lanes[t].type) + "[<ls:" + number(lanes[t].shift) + ">]";
+                add(lanes[t].mask, value, mnemonic, list + ", [<X:5>]");
+                add(lanes[t].mask, value | 0x009F0000, mnemonic,
+                    list + ", [<X:5>], #" + number(selem << lanes[t].shift));
+                add(lanes[t].mask & ~0x001F0000, value | 0x00800000, mnemonic, list + ", [<X:5>], <x:16>");
+            }
+        }
+        unsigned int value = 0x0D40C000 | bits;
+        std::string list = vectorList(selem, "<Al>");
+        add(0xBFFFF000, value, "ld" + number(selem) + "r", list + ", [<X:5>]");
+        for ( unsigned int size = 0; size < 4; size++ ) {
+            add(0xBFFFFC00, value | 0x009F0000 | size << 10, "ld" + number(selem) + "r",
+                list + ", [<X:5>], #" + number(selem << size));
+        }
+        add(0xBFE0F000, value | 0x00800000, "ld" + number(selem) + "r", list + ", [<X:5>], <x:16>");
+    }
+}
+
+void Decoder::addScalarFp() {
+    // Two sources
+    static const char *twoSources[9] = { "fmul", "fdiv", "fadd", "fsub", "fmax", "fmin", "fmaxnm", "fminnm", "fnmul" };
+    for ( unsigned int opcode = 0; opcode < 9; opcode++ ) {
+        add(0xFF20FC00, 0x1E200800 | opcode << 12, twoSources[opcode], "<F:0>, <F:5>, <F:16>");
+    }
+    // One source, fcvt converts from the type field to the one in its opcode
+    static const char *oneSource[16] = { "fmov", "fabs", "fneg", "fsqrt", NULL, NULL, NULL, NULL,
+                                         "frintn", "frintp", "frintm", "frintz", "frinta", NULL, "frintx", "frinti" };
+    for ( unsigned int opcode = 0; opcode < 16; opcode++ ) {
+        if ( oneSource[opcode] ) {
+            add(0xFF3FFC00, 0x1E204000 | opcode << 15, oneSource[opcode], "<F:0>, <F:5>");
+        }
+    }
+    static const char *fcvtTypes[4] = { "s", "d", NULL, "h" };
+    for ( unsigned int from = 0; from < 4; from++ ) {
+        for ( unsigned int to = 0; to < 4; to++ ) {
+            if ( fcvtTypes[from] && fcvtTypes[to] && from != to ) {
+                add(0xFFFFFC00, 0x1E224000 | from << 22 | to << 15, "fcvt",
+                    std::string("<") + fcvtTypes[to] + ":0>, <" + fcvtTypes[from] + ":5>");
+            }
+        }
+    }
+    // Compares, Rm is zero in the compares with zero
+    add(0xFF20FC1F, 0x1E202000, "fcmp", "<F:5>, <F:16>");
+    add(0xFF3FFC1F, 0x1E202008, "fcmp", "<F:5>, #0.0");
+    add(0xFF20FC1F, 0x1E202010, "fcmpe", "<F:5>, <F:16>");
+    add(0xFF3FFC1F, 0x1E202018, "fcmpe", "<F:5>, #0.0");
+    add(0xFF201FE0, 0x1E201000, "fmov", "<F:0>, <fp8:13>");
+    add(0xFF200C10, 0x1E200400, "fccmp", "<F:5>, <F:16>, #<n:3:0:1>, <cond:12>");
+    add(0xFF200C10, 0x1E200410, "fccmpe", "<F:5>, <F:16>, #<n:3:0:1>, <cond:12>");
+    add(0xFF200C00, 0x1E200C00, "fcsel", "<F:0>, <F:5>, <F:16>, <cond:12>");
+    // Three sources
+    static const char *threeSources[4] = { "fmadd", "fmsub", "fnmadd", "fnmsub" };
+    for ( unsigned int op = 0; op < 4; op++ ) {
+        add(0xFF208000, 0x1F000000 | (op >> 1) << 21 | (op & 1) << 15, threeSources[op], "<F:0>, <F:5>, <F:16>, <F:10>");
+    }
+
+    // Conversions between floating-point and integer registers, rmode:opcode
+    static const struct { unsigned int bits; const char *mnemonic; bool toInteger; } conversions[] = {
+        { 0x00, "fcvtns", true }, { 0x01, "fcvtnu", true }, { 0x02, "scvtf", false }, { 0x03, "ucvtf", false },
+        { 0x04, "fcvtas", true }, { 0x05, "fcvtau", true }, { 0x08, "fcvtps", true }, { 0x09, "fcvtpu", true },
+        { 0x10, "fcvtms", true }, { 0x11, "fcvtmu", true }, { 0x18, "fcvtzs", true }, { 0x19, "fcvtzu", true },
+    };
+    add(0xFFFFFC00, 0x9EAE0000, "fmov", "<x:0>, <v:5>.d[1]");
+    add(0xFFFFFC00, 0x9EAF0000, "fmov", "<v:0>.d[1], <x:5>");
+    add(0x7FC00000, 0x1E800000, "", "");
+    for ( unsigned int i = 0; i < sizeof(conversions) / sizeof(conversions[0]); i++ ) {
+        add(0x7F3FFC00, 0x1E200000 | conversions[i].bits << 16, conversions[i].mnemonic,
+            conversions[i].toInteger ? "<R:0>, <F:5>" : "<F:0>, <R:5>");
+    }
+    // fmov needs the integer register to be as wide as the floating-point one (or a half)
+    static const struct { unsigned int bits; const char *rd; const char *rn; } moves[] = {
+        { 0x1E260000, "<w:0>", "<s:5>" }, { 0x1E270000, "<s:0>", "<w:5>" },
+        { 0x1EE60000, "<w:0>", "<h:5>" }, { 0x1EE70000, "<h:0>", "<w:5>" },
+        { 0x9E660000, "<x:0>", "<d:5>" }, { 0x9E670000, "<d:0>", "<x:5>" },
+        { 0x9EE60000, "<x:0>", "<h:5>" }, { 0x9EE70000, "<h:0>", "<x:5>" },
+    };
+    for ( unsigned int i = 0; i < sizeof(moves) / sizeof(moves[0]); i++ ) {
+        add(0xFFFFFC00, moves[i].bits, "fmov", std::string(moves[i].rd) + ", " + moves[i].rn);
+    }
+
+    // Conversions with fixed-point integers, 32-bit registers take at most 32 fraction bits
+    add(0xFF208000, 0x1E000000, "", "");
+    static const struct { unsigned int bits; const char *mnemonic; bool toInteger; } fixed[] = {
+        { 0x02, "scvtf", false }, { 0x03, "ucvtf", false }, { 0x18, "fcvtzs", true }, { 0x19, "fcvtzu", true },
+    };
+    for ( unsigned int i = 0; i < sizeof(fixed) / sizeof(fixed[0]); i++ ) {
+        add(0x7F3F0000, 0x1E000000 | fixed[i].bits << 16, fixed[i].mnemonic,
+            fixed[i].toInteger ? "<R:0>, <F:5>, #<rsh:15:10:64>" : "<F:0>, <R:5>, #<rsh:15:10:64>");
+    }
+}
+
+void Decoder::addAdvSimd() {
+    // Scalar three same, only the sizes listed are allocated
+    static const struct { unsigned int u; unsigned int opcode; const char *mnemonic; unsigned int sizes; } scalarSame[] = {
+        { 0, 0x01, "sqadd", 0xF }, { 0, 0x05, "sqsub", 0xF }, { 0, 0x06, "cmgt", 0x8 }, { 0, 0x07, "cmge", 0x8 },
+        { 0, 0x08, "sshl", 0x8 }, { 0, 0x09, "sqshl", 0xF }, { 0, 0x0A, "srshl", 0x8 }, { 0, 0x0B, "sqrshl", 0xF },
+        { 0, 0x10, "add", 0x8 }, { 0, 0x11, "cmtst", 0x8 }, { 0, 0x16, "sqdmulh", 0x6 },
+        { 1, 0x01, "uqadd", 0xF }, { 1, 0x05, "uqsub", 0xF }, { 1, 0x06, "cmhi", 0x8 }, { 1, 0x07, "cmhs", 0x8 },
+        { 1, 0x08, "ushl", 0x8 }, { 1, 0x09, "uqshl", 0xF }, { 1, 0x0A, "urshl", 0x8 }, { 1, 0x0B, "uqrshl", 0xF },
+        { 1, 0x10, "sub", 0x8 }, { 1, 0x11, "cmeq", 0x8 }, { 1, 0x16, "sqrdmulh", 0x6 },
+    };
+    for ( unsigned int i = 0; i < sizeof(scalarSame) / sizeof(scalarSame[0]); i++ ) {
+        for ( unsigned int size = 0; size < 4; size++ ) {
+            if ( scalarSame[i].sizes & (1U << size) ) {
+                add(0xFFE0FC00, 0x5E200400 | scalarSame[i].u << 29 | size << 22 | scalarSame[i].opcode << 11,
+                    scalarSame[i].mnemonic, "<S:0>, <S:5>, <S:16>");
+            }
+        }
+    }
+    // Scalar three same floating-point, u:a:opcode
+    static const struct { unsigned int u; unsigned int a; unsigned int opcode; const char *mnemonic; } scalarSameFp[] = {
+        { 0, 0, 0x1B, "fmulx" }, { 0, 0, 0x1C, "fcmeq" }, { 0, 0, 0x1F, "frecps" }, { 0, 1, 0x1F, "frsqrts" },
+        { 1, 0, 0x1C, "fcmge" }, { 1, 0, 0x1D, "facge" }, { 1, 1, 0x1A, "fabd" }, { 1, 1, 0x1C, "fcmgt" },
+        { 1, 1, 0x1D, "facgt" },
+    };
+    for ( unsigned int i = 0; i < sizeof(scalarSameFp) / sizeof(scalarSameFp[0]); i++ ) {
+        add(0xFFA0FC00, 0x5E200400 | scalarSameFp[i].u << 29 | scalarSameFp[i].a << 23 | scalarSameFp[i].opcode << 11,
+            scalarSameFp[i].mnemonic, "<Sf:0>, <Sf:5>, <Sf:16>");
+    }
+
+    // Scalar two-register miscellaneous
+    static const struct { unsigned int u; unsigned int opcode; const char *mnemonic; unsigned int sizes; const char *operands; } scalarMisc[] = {
+        { 0, 0x03, "suqadd", 0xF, "<S:0>, <S:5>" }, { 0, 0x07, "sqabs", 0xF, "<S:0>, <S:5>" },
+        { 0, 0x08, "cmgt", 0x8, "<d:0>, <d:5>, #0" }, { 0, 0x09, "cmeq", 0x8, "<d:0>, <d:5>, #0" },
+        { 0, 0x0A, "cmlt", 0x8, "<d:0>, <d:5>, #0" }, { 0, 0x0B, "abs", 0x8, "<d:0>, <d:5>" },
+        { 1, 0x03, "usqadd", 0xF, "<S:0>, <S:5>" }, { 1, 0x07, "sqneg", 0xF, "<S:0>, <S:5>" },
+        { 1, 0x08, "cmge", 0x8, "<d:0>, <d:5>, #0" }, { 1, 0x09, "cmle", 0x8, "<d:0>, <d:5>, #0" },
+        { 1, 0x0B, "neg", 0x8, "<d:0>, <d:5>" },
+    };
+    for ( unsigned int i = 0; i < sizeof(scalarMisc) / sizeof(scalarMisc[0]); i++ ) {
+        for ( unsigned int size = 0; size < 4; size++ ) {
+            if ( scalarMisc[i].sizes & (1U << size) ) {
+                add(0xFFFFFC00, 0x5E200800 | scalarMisc[i].u << 29 | size << 22 | scalarMisc[i].opcode << 12,
+                    scalarMisc[i].mnemonic, scalarMisc[i].operands);
+            }
+        }
+    }
+    // Narrowing ones write half the source size
+    static const struct { unsigned int u; unsigned int opcode; const char *mnemonic; } narrowing[] = {
+        { 0, 0x14, "sqxtn" }, { 1, 0x12, "sqxtun" }, { 1, 0x14, "uqxtn" },
+    };
+    static const char *narrowRegs[3] = { "<b:0>, <h:5>", "<h:0>, <s:5>", "<s:0>, <d:5>" };
+    for ( unsigned int i = 0; i < sizeof(narrowing) / sizeof(narrowing[0]); i++ ) {
+        for ( unsigned int size = 0; size < 3; size++ ) {
+            add(0xFFFFFC00, 0x5E200800 | narrowing[i].u << 29 | size << 22 | narrowing[i].opcode << 12,
+                narrowing[i].mnemonic, narrowRegs[size]);
+        }
+    }
+    add(0xFFFFFC00, 0x7E616800, "fcvtxn", "<s:0>, <d:5>");
+    // Floating-point ones, u:a:opcode
+    static const struct { unsigned int u; unsigned int a; unsigned int opcode; const char *mnemonic; const char *operands; } scalarMiscFp[] = {
+        { 0, 0, 0x1A, "fcvtns", "<Sf:0>, <Sf:5>" }, { 0, 0, 0x1B, "fcvtms", "<Sf:0>, <Sf:5>" },
+        { 0, 0, 0x1C, "fcvtas", "<Sf:0>, <Sf:5>" }, { 0, 0, 0x1D, "scvtf", "<Sf:0>, <Sf:5>" },
+        { 0, 1, 0x0C, "fcmgt", "<Sf:0>, <Sf:5>, #0.0" }, { 0, 1, 0x0D, "fcmeq", "<Sf:0>, <Sf:5>, #0.0" },
+        { 0, 1, 0x0E, "fcmlt", "<Sf:0>, <Sf:5>, #0.0" }, { 0, 1, 0x1A, "fcvtps", "<Sf:0>, <Sf:5>" },
+        { 0, 1, 0x1B, "fcvtzs", "<Sf:0>, <Sf:5>" }, { 0, 1, 0x1D, "frecpe", "<Sf:0>, <Sf:5>" },
+        { 0, 1, 0x1F, "frecpx", "<Sf:0>, <Sf:5>" },
+        { 1, 0, 0x1A, "fcvtnu", "<Sf:0>, <Sf:5>" }, { 1, 0, 0x1B, "fcvtmu", "<Sf:0>, <Sf:5>" },
+        { 1, 0, 0x1C, "fcvtau", "<Sf:0>, <Sf:5>" }, { 1, 0, 0x1D, "ucvtf", "<Sf:0>, <Sf:5>" },
+        { 1, 1, 0x0C, "fcmge", "<Sf:0>, <Sf:5>, #0.0" }, { 1, 1, 0x0D, "fcmle", "<Sf:0>, <Sf:5>, #0.0" },
+        { 1, 1, 0x1A, "fcvtpu", "<Sf:0>, <Sf:5>" }, { 1, 1, 0x1B, "fcvtzu", "<Sf:0>, <Sf:5>" },
+        { 1, 1, 0x1D, "frsqrte", "<Sf:0>, <Sf:5>" },
+    };
+    for ( unsigned int i = 0; i < sizeof(scalarMiscFp) / sizeof(scalarMiscFp[0]); i++ ) {
+        add(0xFFBFFC00, 0x5E200800 | scalarMiscFp[i].u << 29 | scalarMiscFp[i].a << 23 | scalarMiscFp[i].opcode << 12,
+            scalarMiscFp[i].mnemonic, scalarMiscFp[i].operands);
+    }
+
+    // Scalar shifts by immediate on 64-bit elements, and fixed-point conversions
+    static const struct { unsigned int u; unsigned int opcode; const char *mnemonic; bool left; } scalarShifts[] = {
+        { 0, 0x00, "sshr", false }, { 0, 0x02, "ssra", false }, { 0, 0x04, "srshr", false }, { 0, 0x06, "srsra", false },
+        { 0, 0x0A, "shl", true }, { 0, 0x0E, "sqshl", true },
+        { 1, 0x00, "ushr", false }, { 1, 0x02, "usra", false }, { 1, 0x04, "urshr", false }, { 1, 0x06, "ursra", false },
+        { 1, 0x08, "sri", false }, { 1, 0x0A, "sli", true }, { 1, 0x0C, "sqshlu", true }, { 1, 0x0E, "uqshl", true },
+    };
+    for ( unsigned int i = 0; i < sizeof(scalarShifts) / sizeof(scalarShifts[0]); i++ ) {
+        add(0xFFC0FC00, 0x5F400400 | scalarShifts[i].u << 29 | scalarShifts[i].opcode << 11, scalarShifts[i].mnemonic,
+            scalarShifts[i].left ? "<d:0>, <d:5>, #<n:21:16:1>" : "<d:0>, <d:5>, #<rsh:21:16:64>");
+    }
+    // Narrowing shifts, only listed for 64-bit sources
+    static const struct { unsigned int u; unsigned int opcode; const char *mnemonic; } scalarNarrow[] = {
+        { 0, 0x12, "sqshrn" }, { 0, 0x13, "sqrshrn" }, { 1, 0x10, "sqshrun" }, { 1, 0x11, "sqrshrun" },
+        { 1, 0x12, "uqshrn" }, { 1, 0x13, "uqrshrn" },
+    };
+    for ( unsigned int i = 0; i < sizeof(scalarNarrow) / sizeof(scalarNarrow[0]); i++ ) {
+        add(0xFFE0FC00, 0x5F200400 | scalarNarrow[i].u << 29 | scalarNarrow[i].opcode << 11, scalarNarrow[i].mnemonic,
+            "<s:0>, <d:5>, #<rsh:20:16:32>");
+    }
+    static const struct { unsigned int u; unsigned int opcode; const char *mnemonic; } scalarFixed[] = {
+        { 0, 0x1C, "scvtf" }, { 0, 0x1F, "fcvtzs" }, { 1, 0x1C, "ucvtf" }, { 1, 0x1F, "fcvtzu" },
+    };
+    for ( unsigned int i = 0; i < sizeof(scalarFixed) / sizeof(scalarFixed[0]); i++ ) {
+        unsigned int bits = scalarFixed[i].u << 29 | scalarFixed[i].opcode << 11;
+        add(0xFFC0FC00, 0x5F400400 | bits, scalarFixed[i].mnemonic, "<d:0>, <d:5>, #<rsh:21:16:64>");
+        add(0xFFE0FC00, 0x5F200400 | bits, scalarFixed[i].mnemonic, "<s:0>, <s:5>, #<rsh:20:16:32>");
+    }
+
+    // Scalar pairwise reductions
+    static const struct { unsigned int a; unsigned int opcode; const char *mnemonic; } pairwise[] = {
+        { 0, 0x0C, "fmaxnmp" }, { 0, 0x0D, "faddp" }, { 0, 0x0F, "fmaxp" }, { 1, 0x0C, "fminnmp" }, { 1, 0x0F, "fminp" },
+    };
+    for ( unsigned int i = 0; i < sizeof(pairwise) / sizeof(pairwise[0]); i++ ) {
+        unsigned int value = 0x7E300800 | pairwise[i].a << 23 | pairwise[i].opcode << 12;
+        add(0xFFFFFC00, value, pairwise[i].mnemonic, "<s:0>, <v:5>.2s");
+        add(0xFFFFFC00, value | 0x00400000, pairwise[i].mnemonic, "<d:0>, <v:5>.2d");
+    }
+    add(0xFFFFFC00, 0x5EF1B800, "addp", "<d:0>, <v:5>.2d");
+
+    // Scalar by element, floating-point
+    static const struct { unsigned int u; unsigned int opcode; const char *mnemonic; } byElement[] = {
+        { 0, 0x1, "fmla" }, { 0, 0x5, "fmls" }, { 0, 0x9, "fmul" }, { 1, 0x9, "fmulx" },
+    };
+    for ( unsigned int i = 0; i < sizeof(byElement) / sizeof(byElement[0]); i++ ) {
+        unsigned int bits = byElement[i].u << 29 | byElement[i].opcode << 12;
+        add(0xFFC0F400, 0x5F800000 | bits, byElement[i].mnemonic, "<s:0>, <s:5>, <v:16>.s[<hl>]");
+        add(0xFFE0F400, 0x5FC00000 | bits, byElement[i].mnemonic, "<d:0>, <d:5>, <v:16>.d[<n:11:11:1>]");
+        // Vector forms
+        add(0xBFC0F400, 0x0F800000 | bits, byElement[i].mnemonic, "<v:0>.<Af>, <v:5>.<Af>, <v:16>.s[<hl>]");
+        add(0xBFE0F400, 0x0FC00000 | bits, byElement[i].mnemonic, "<v:0>.<Af>, <v:5>.<Af>, <v:16>.d[<n:11:11:1>]");
+    }
+
+    // Copies between elements and general-purpose registers
+    add(0xBFE0FC00, 0x0E000400, "dup", "<v:0>.<Q5>, <v:5>.<e5>[<i5>]");
+    add(0xBFE0FC00, 0x0E000C00, "dup", "<v:0>.<Q5>, <G5:5:1>");
+    add(0xFFE0FC00, 0x4E001C00, "mov", "<v:0>.<e5>[<i5>], <G5:5>");
+    add(0xFFEFFC00, 0x0E083C00, "", "");
+    add(0xFFE7FC00, 0x0E043C00, "mov", "<w:0>, <v:5>.s[<i5>]");
+    add(0xFFEFFC00, 0x4E083C00, "mov", "<x:0>, <v:5>.d[<i5>]");
+    add(0xFFE1FC00, 0x0E013C00, "umov", "<w:0>, <v:5>.b[<i5>]");
+    add(0xFFE3FC00, 0x0E023C00, "umov", "<w:0>, <v:5>.h[<i5>]");
+    add(0xFFE1FC00, 0x0E012C00, "smov", "<w:0>, <v:5>.b[<i5>]");
+    add(0xFFE3FC00, 0x0E022C00, "smov", "<w:0>, <v:5>.h[<i5>]");
+    add(0xFFE1FC00, 0x4E012C00, "smov", "<x:0>, <v:5>.b[<i5>]");
+    add(0xFFE3FC00, 0x4E022C00, "smov", "<x:0>, <v:5>.h[<i5>]");
+    add(0xFFE7FC00, 0x4E042C00, "smov", "<x:0>, <v:5>.s[<i5>]");
+    add(0xFFE08400, 0x6E000400, "mov", "<v:0>.<e5>[<i5>], <v:5>.<e5>[<i4>]");
+
+    // Three same, floating-point, u:a:opcode
+    static const struct { unsigned int u; unsigned int a; unsigned int opcode; const char *mnemonic; } sameFp[] = {
+        { 0, 0, 0x18, "fmaxnm" }, { 0, 0, 0x19, "fmla" }, { 0, 0, 0x1A, "fadd" }, { 0, 0, 0x1B, "fmulx" },
+        { 0, 0, 0x1C, "fcmeq" }, { 0, 0, 0x1E, "fmax" }, { 0, 0, 0x1F, "frecps" },
+        { 0, 1, 0x18, "fminnm" }, { 0, 1, 0x19, "fmls" }, { 0, 1, 0x1A, "fsub" }, { 0, 1, 0x1E, "fmin" },
+        { 0, 1, 0x1F, "frsqrts" },
+        { 1, 0, 0x18, "fmaxnmp" }, { 1, 0, 0x1A, "faddp" }, { 1, 0, 0x1B, "fmul" }, { 1, 0, 0x1C, "fcmge" },
+        { 1, 0, 0x1D, "facge" }, { 1, 0, 0x1E, "fmaxp" }, { 1, 0, 0x1F, "fdiv" },
+        { 1, 1, 0x18, "fminnmp" }, { 1, 1, 0x1A, "fabd" }, { 1, 1, 0x1C, "fcmgt" }, { 1, 1, 0x1D, "facgt" },
+        { 1, 1, 0x1E, "fminp" },
+    };
+    for ( unsigned int i = 0; i < sizeof(sameFp) / sizeof(sameFp[0]); i++ ) {
+        add(0xBFA0FC00, 0x0E200400 | sameFp[i].u << 29 | sameFp[i].a << 23 | sameFp[i].opcode << 11,
+            sameFp[i].mnemonic, "<v:0>.<Af>, <v:5>.<Af>, <v:16>.<Af>");
+    }
+    // Three same, integer. 'sizes' lists the allocated element sizes
+    static const struct { unsigned int u; unsigned int opcode; const char *mnemonic; unsigned int sizes; } sameInt[] = {
+        { 0, 0x00, "shadd", 0x7 }, { 0, 0x01, "sqadd", 0xF }, { 0, 0x02, "srhadd", 0x7 }, { 0, 0x04, "shsub", 0x7 },
+        { 0, 0x05, "sqsub", 0xF }, { 0, 0x06, "cmgt", 0xF }, { 0, 0x07, "cmge", 0xF }, { 0, 0x08, "sshl", 0xF },
+        { 0, 0x09, "sqshl", 0xF }, { 0, 0x0A, "srshl", 0xF }, { 0, 0x0B, "sqrshl", 0xF }, { 0, 0x0C, "smax", 0x7 },
+        { 0, 0x0D, "smin", 0x7 }, { 0, 0x0E, "sabd", 0x7 }, { 0, 0x0F, "saba", 0x7 }, { 0, 0x10, "add", 0xF },
+        { 0, 0x11, "cmtst", 0xF }, { 0, 0x12, "mla", 0x7 }, { 0, 0x13, "mul", 0x7 }, { 0, 0x14, "smaxp", 0x7 },
+        { 0, 0x15, "sminp", 0x7 }, { 0, 0x16, "sqdmulh", 0x6 }, { 0, 0x17, "addp", 0xF },
+        { 1, 0x00, "uhadd", 0x7 }, { 1, 0x01, "uqadd", 0xF }, { 1, 0x02, "urhadd", 0x7 }, { 1, 0x04, "uhsub", 0x7 },
+        { 1, 0x05, "uqsub", 0xF }, { 1, 0x06, "cmhi", 0xF }, { 1, 0x07, "cmhs", 0xF }, { 1, 0x08, "ushl", 0xF },
+        { 1, 0x09, "uqshl", 0xF }, { 1, 0x0A, "urshl", 0xF }, { 1, 0x0B, "uqrshl", 0xF }, { 1, 0x0C, "umax", 0x7 },
+        { 1, 0x0D, "umin", 0x7 }, { 1, 0x0E, "uabd", 0x7 }, { 1, 0x0F, "uaba", 0x7 }, { 1, 0x10, "sub", 0xF },
+        { 1, 0x11, "cmeq", 0xF }, { 1, 0x12, "mls", 0x7 }, { 1, 0x13, "pmul", 0x1 }, { 1, 0x14, "umaxp", 0x7 },
+        { 1, 0x15, "uminp", 0x7 }, { 1, 0x16, "sqrdmulh", 0x6 },
+    };
+    for ( unsigned int i = 0; i < sizeof(sameInt) / sizeof(sameInt[0]); i++ ) {
+        for ( unsigned int size = 0; size < 4; size++ ) {
+            if ( sameInt[i].sizes & (1U << size) ) {
+                add(0xBFE0FC00, 0x0E200400 | sameInt[i].u << 29 | size << 22 | sameInt[i].opcode << 11,
+                    sameInt[i].mnemonic, "<v:0>.<A>, <v:5>.<A>, <v:16>.<A>");
+            }
+        }
+    }
+    // Three same, logical. orr of a register with itself is a move
+    static const char *logical[2][4] = { { "and", "bic", "orr", "orn" }, { "eor", "bsl", "bit", "bif" } };
+    for ( unsigned int u = 0; u < 2; u++ ) {
+        for ( unsigned int size = 0; size < 4; size++ ) {
+            unsigned int value = 0x0E201C00 | u << 29 | size << 22;
+            if ( u == 0 && size == 2 ) {
+                for ( unsigned int r = 0; r < 32; r++ ) {
+                    add(0xBFFFFFE0, value | r << 16 | r << 5, "mov", "<v:0>.<A8>, <v:5>.<A8>");
+                }
+            }
+            add(0xBFE0FC00, value, logical[u][size], "<v:0>.<A8>, <v:5>.<A8>, <v:16>.<A8>");
+        }
+    }
+}
+
+Decoder::Decoder() {
+    addSve();
+    addSveLoads();
+    addScalarLoads();
+    addAdvSimdLoads();
+    addScalarFp();
+    addAdvSimd();
+}
+
+bool Decoder::decode(unsigned int encoding, std::string &mnemonic, std::string &operands) const {
+    for ( unsigned int i = 0; i < patterns.size(); i++ ) {
+        const Pattern &pattern = patterns[i];
+        if ( (encoding & pattern.mask) != pattern.value ) {
+            continue;
+        }
+        if ( pattern.mnemonic.empty() || !format(encoding, pattern.operands, operands) ) {
+            return false;
+        }
+        mnemonic = pattern.mnemonic;
+        return true;
+    }
+    return false;
+}
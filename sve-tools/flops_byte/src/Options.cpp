@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Options.hpp"
+
+/*
+ * Private functions
+ */
+void printUsage() {
+    std::cout << "flops_byte [OPTIONS] meminstrace_file veclen" << std::endl;
+    exit(1);
+}
+
+void printHelp() {
+    std::cout << "flops_byte [OPTIONS] meminstrace_file veclen" << std::endl;
+    std::cout << "  veclen           SVE vector length in bits: 128, 256, 512, 1024 or 2048" << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "\t-q               Report quad-precision numbers (16 bytes per lane)" << std::endl;
+    std::cout << "\t-c <cacheFile>   Decode cache, reused and extended across runs (default: none)" << std::endl;
+    std::cout << "\t-r <regionsFile> Report FLOPs and bytes per region, one \"start,end,name\" range per line" << std::endl;
+    std::cout << "\t-l               Report FLOPs and bytes per loop, detected from backward transfers" << std::endl;
+    std::cout << "\t-o <outputFile>  Redirect output to <outputFile> (default: stdout)" << std::endl;
+#ifdef ENABLE_GZIP
+    std::cout << "\t-z               Input file is zipped (default: no zip)" << std::endl;
+#endif
+    std::cout << "\t-h               Print this help" << std::endl;
+    exit(0);
+}
+
+/*
+ * Public functions
+ */
+Options::Options() {
+    outputFile = std::string();
+    traceFile = std::string();
+    cacheFile = std::string();
+    regionsFile = std::string();
+    loops = false;
+    vectorLength = 0;
+    quad = false;
+#ifdef ENABLE_GZIP
+    zipped = false;
+#endif
+}
+
+void Options::readOptions(int argc, char *argv[]) {
+    int c;
+    int fileFounds = 0;
+    int optind2 = 1;
+    while ( optind2 < argc ) {
+#ifdef ENABLE_GZIP
+        if (( c = getopt(argc, argv, "qc:r:lo:zh")) != -1 ) {
+#else
+        if (( c = getopt(argc, argv, "qc:r:lo:h")) != -1 ) {
+#endif
+            switch(c) {
+                case 'o':
+                    optind2++;
+                    this->outputFile = std::string(argv[optind2]);
+                    optind2++;
+                    break;
+#ifdef ENABLE_GZIP
+                case 'z':
+                    this->zipped = true;
+                    optind2++;
+                    break;
+#endif
+                case 'c':
+                    optind2++;
+                    this->cacheFile = std::string(argv[optind2]);
+                    optind2++;
+                    break;
+                case 'r':
+                    optind2++;
+                    this->regionsFile = std::string(argv[optind2]);
+                    optind2++;
+                    break;
+                case 'l':
+                    this->loops = true;
+                    optind2++;
+                    break;
+                case 'q':
+                    this->quad = true;
+                    optind2++;
+                    break;
+                case 'h':
+                    printHelp();
+                    break;
+                default:
+                    printUsage();
+                    break;
+            }
+        } else {
+            if ( fileFounds == 0 ) {
+                this->traceFile = std::string(argv[optind2]);
+                if ( access(this->traceFile.c_str(), F_OK) == -1 ) {
+                    std::cout << "Meminstrace file not found! Exiting..." << std::endl;
+                    exit(1);
+                }
+            } else if ( fileFounds == 1 ) {
+                this->vectorLength = std::stoi(argv[optind2]);
+            }
+            fileFounds++;
+            optind2++;
+        }
+    }
+    if ( fileFounds != 2 ) {
+        printUsage();
+    }
+    if ( vectorLength != 128 && vectorLength != 256 && vectorLength != 512 && vectorLength != 1024 &&
+         vectorLength != 2048 ) {
+        std::cout << "The vector length must be 128, 256, 512, 1024 or 2048! Exiting..." << std::endl;
+        exit(1);
+    }
+}
+
+std::string Options::getTraceFile() {
+    return traceFile;
+}
+
+std::string Options::getOutFile() {
+    return outputFile;
+}
+
+std::string Options::getCacheFile() {
+    return cacheFile;
+}
+
+std::string Options::getRegionsFile() {
+    return regionsFile;
+}
+
+bool Options::detectLoops() {
+    return loops;
+}
+
+unsigned int Options::getVectorLength() {
+    return vectorLength;
+}
+
+bool Options::isQuad() {
+    return quad;
+}
+
+#ifdef ENABLE_GZIP
+bool Options::isZipped() {
+    return zipped;
+}
+#endif
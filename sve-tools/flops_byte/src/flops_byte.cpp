@@ -0,0 +1,510 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Options.hpp"
+#include "DecodeCache.hpp"
+#include "Regions.hpp"
+#include "LoopTable.hpp"
+
+#include <fstream>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <algorithm>
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef ENABLE_GZIP
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#endif
+
+// Masks for SVE, SIMD and scalar float instructions
+#define SVE_MASK 0x64000000
+#define SIMD_FLOAT_MASK 0x0E000000
+
+// Register files in the order of the final update, and the number of registers of each
+enum regClass { Z_REG, X_REG, W_REG, Q_REG, D_REG, NO_REG };
+const unsigned int regRange[NO_REG] = { 32, 31, 31, 16, 32 };
+#define MAX_REGS 32
+
+#define MAX_LANE_SIZES 5
+
+struct regCounters {
+    double flops;
+    unsigned long bytes;
+};
+
+// FLOPs and bytes loaded by the instructions at a PC, for the per-region report
+struct pcCounters {
+    unsigned long instructions;
+    double flops;
+    unsigned long bytes;
+};
+
+// What the accounting needs from an instruction, worked out once per encoding
+struct signature {
+    bool valid;                  // false if llvm-mc rejects the encoding: no FLOPs, no destination
+    bool undecoded;              // neither the tables nor llvm-mc decoded it
+    bool reported;
+    bool floating;               // matches one of the opcode masks
+    double weight;               // 1 / number of source operands
+    std::vector< std::pair<int, unsigned int> > sources;
+    int loadClass;               // register class of the first operand, NO_REG if not a register
+    unsigned int loadIndex;
+};
+
+std::string outputFileName;
+std::ofstream outputFile;
+
+DecodeCache *decodeCache;
+std::unordered_map<unsigned int, signature> signatures;
+unsigned int undecodedEncodings;
+
+regCounters regs[NO_REG][MAX_REGS];
+unsigned int laneSizes;
+double vectorBytes;
+double flopsByteG[MAX_LANE_SIZES];
+double flopsByteInv[MAX_LANE_SIZES];
+unsigned long flopsByteCntr;
+
+std::unordered_map<unsigned long, pcCounters> pcStats;
+// Loops found in the trace with -l
+LoopTable loops;
+
+// The first register file whose letter appears in the operand, as the Python tool does
+int getRegClass ( const std::string &operand ) {
+    const char *letters = "zxwqd";
+    for ( int i = Z_REG; i < NO_REG; i++ ) {
+        if ( operand.find(letters[i]) != std::string::npos ) {
+            return i;
+        }
+    }
+    return NO_REG;
+}
+
+bool getRegIndex ( const std::string &operand, unsigned int &index ) {
+    size_t start = operand.find_first_of("0123456789");
+    if ( start == std::string::npos ) {
+        return false;
+    }
+    index = std::strtoul(operand.c_str() + start, NULL, 10);
+    return index < MAX_REGS;
+}
+
+const signature &getSignature ( unsigned int encoding ) {
+    std::unordered_map<unsigned int, signature>::iterator it = signatures.find(encoding);
+    if ( it != signatures.end() ) {
+        return it->second;
+    }
+
+    signature &sig = signatures[encoding];
+    sig.valid = true;
+    sig.undecoded = false;
+    sig.reported = false;
+    sig.floating = (encoding & SVE_MASK) == SVE_MASK || (encoding & SIMD_FLOAT_MASK) == SIMD_FLOAT_MASK;
+    sig.weight = 0.0;
+    sig.loadClass = NO_REG;
+    sig.loadIndex = 0;
+
+    std::string mnemonic, operands;
+    switch ( decodeCache->decode(encoding, mnemonic, operands) ) {
+        case DecodeCache::UNKNOWN:
+            // Without llvm-mc, or if it failed, take it as an instruction with no register operands
+            sig.undecoded = true;
+            return sig;
+        case DecodeCache::INVALID:
+            sig.valid = false;
+            return sig;
+        default:
+            break;
+    }
+
+    // Destination of a load: the first operand, if it is a x, w, q, d or z register
+    std::string first = operands.substr(0, operands.find(','));
+    if ( (first.size() > 1 && strchr("xwqd", first[0]) != NULL && isdigit(first[1])) ||
+         (first.compare(0, 3, "{ z") == 0 && first.size() > 3 && isdigit(first[3])) ) {
+        if ( getRegIndex(first, sig.loadIndex) ) {
+            sig.loadClass = getRegClass(first);
+        }
+    }
+
+    // Sources of a floating point operation: every operand but the first
+    std::string compact;
+    for ( unsigned int i = 0; i < operands.size(); i++ ) {
+        if ( !isspace(operands[i]) ) {
+            compact += operands[i];
+        }
+    }
+    std::vector<std::string> tokens;
+    size_t start = 0;
+    while ( !operands.empty() ) {
+        size_t comma = compact.find(',', start);
+        tokens.push_back(compact.substr(start, comma - start));
+        if ( comma == std::string::npos ) {
+            break;
+        }
+        start = comma + 1;
+    }
+    if ( tokens.size() > 1 ) {
+        sig.weight = 1.0 / (tokens.size() - 1);
+    }
+    for ( unsigned int i = 1; i < tokens.size(); i++ ) {
+        unsigned int index;
+        int regClass = getRegClass(tokens[i]);
+        if ( !tokens[i].empty() && tokens[i].find_first_not_of("xzwsqd0123456789.") == std::string::npos &&
+             regClass != NO_REG && getRegIndex(tokens[i], index) ) {
+            sig.sources.push_back(std::make_pair(regClass, index));
+        }
+    }
+    return sig;
+}
+
+void reportUndecoded ( const signature &sig ) {
+    if ( sig.undecoded && !sig.reported ) {
+        const_cast<signature &>(sig).reported = true;
+        undecodedEncodings++;
+    }
+}
+
+// Fold the FLOPs of a register over the bytes loaded into it, for every lane size
+void updateFlopsByte ( int regClass, unsigned int index ) {
+    regCounters &reg = regs[regClass][index];
+    double numEl = vectorBytes;
+    bool updated = false;
+    for ( unsigned int i = 0; i < laneSizes; i++ ) {
+        if ( reg.flops != 0 && reg.bytes != 0 ) {
+            flopsByteG[i] += (reg.flops * numEl) / reg.bytes;
+            flopsByteInv[i] += reg.bytes / (reg.flops * numEl);
+            updated = true;
+        }
+        numEl /= 2;
+    }
+    if ( updated ) { // Update the average counter just once
+        flopsByteCntr++;
+    }
+    reg.flops = 0;
+}
+
+void printTitle ( std::ostream &os, const char *title ) {
+    os << std::endl << "====" << std::endl << " " << title << " " << std::endl << "====" << std::endl << std::endl;
+}
+
+void printMeans ( std::ostream &os ) {
+    char buffer[64];
+    double numEl = vectorBytes;
+    for ( unsigned int i = 0; i < laneSizes; i++ ) {
+        snprintf(buffer, sizeof(buffer), "[%.0f lanes, %.0f Bytes ea]", numEl, vectorBytes / numEl);
+        os << buffer << std::endl;
+        snprintf(buffer, sizeof(buffer), "Arithmetic mean = %.4f", flopsByteG[i] / flopsByteCntr);
+        os << buffer << std::endl;
+        snprintf(buffer, sizeof(buffer), "Harmonic mean = %.4f", flopsByteCntr / flopsByteInv[i]);
+        os << buffer << std::endl;
+        numEl /= 2;
+    }
+}
+
+bool moreInstructions ( const std::pair<std::string, pcCounters> &a, const std::pair<std::string, pcCounters> &b ) {
+    return a.second.instructions > b.second.instructions;
+}
+
+/*
+ * FLOPs and bytes of every region, a PC counting for the innermost region that contains it.
+ * The intensity is given for every lane size, as FLOPs scale with the number of lanes
+ */
+void printRegions ( std::ostream &os, Regions &regions ) {
+    std::vector< std::pair<std::string, pcCounters> > rows(regions.size() + 1);
+    std::vector<int> index(regions.size() + 1);
+    for ( std::unordered_map<unsigned long, pcCounters>::iterator it = pcStats.begin(); it != pcStats.end(); it++ ) {
+        int i = regions.find(it->first);
+        pcCounters &row = rows[i < 0 ? regions.size() : i].second;
+        row.instructions += it->second.instructions;
+        row.flops += it->second.flops;
+        row.bytes += it->second.bytes;
+    }
+    char buffer[64];
+    for ( unsigned int i = 0; i < regions.size(); i++ ) {
+        snprintf(buffer, sizeof(buffer), ",0x%lx,0x%lx", regions[i].start, regions[i].end);
+        rows[i].first = regions[i].name + buffer;
+    }
+    rows[regions.size()].first = "other,,";
+    std::stable_sort(rows.begin(), rows.end() - 1, moreInstructions);
+
+    printTitle(os, "Arithmetic intensity per region");
+    os << "region,start,end,instructions,FLOPs,bytes loaded";
+    double numEl = vectorBytes;
+    for ( unsigned int i = 0; i < laneSizes; i++ ) {
+        snprintf(buffer, sizeof(buffer), ",FLOPs/byte [%.0f lanes]", numEl);
+        os << buffer;
+        numEl /= 2;
+    }
+    os << std::endl;
+    for ( unsigned int i = 0; i < rows.size(); i++ ) {
+        const pcCounters &row = rows[i].second;
+        if ( row.instructions == 0 ) {
+            continue;
+        }
+        snprintf(buffer, sizeof(buffer), "%.4f", row.flops);
+        os << rows[i].first << "," << row.instructions << "," << buffer << "," << row.bytes;
+        numEl = vectorBytes;
+        for ( unsigned int j = 0; j < laneSizes; j++ ) {
+            snprintf(buffer, sizeof(buffer), ",%.4f", row.bytes ? row.flops * numEl / row.bytes : 0.0);
+            os << buffer;
+            numEl /= 2;
+        }
+        os << std::endl;
+    }
+}
+
+int main (int argc, char *argv[]) {
+    Options opt;
+    opt.readOptions(argc, argv);
+
+    // We compute FLOP/Byte assuming a constant number of lanes, up to double or quad precision
+    laneSizes = opt.isQuad() ? 5 : 4;
+    vectorBytes = opt.getVectorLength() / 8.0;
+    flopsByteCntr = 0;
+    for ( unsigned int i = 0; i < MAX_LANE_SIZES; i++ ) {
+        flopsByteG[i] = 0.0;
+        flopsByteInv[i] = 0.0;
+    }
+    memset(regs, 0, sizeof(regs));
+
+    // llvm-mc is optional, it only decodes what the tables do not cover
+    const char *mc = getenv("LLVM_MC");
+    std::string llvmMc = mc ? std::string(mc) : std::string();
+    undecodedEncodings = 0;
+
+    std::string cacheFileName = opt.getCacheFile();
+    decodeCache = new DecodeCache(llvmMc);
+    if ( !cacheFileName.empty() && !decodeCache->load(cacheFileName) ) {
+        std::cout << "Cannot read the decode cache " << cacheFileName << "! Exiting..." << std::endl;
+        exit(1);
+    }
+
+    // Regions from a file and/or the loops found in the trace
+    Regions regions;
+    std::string regionsFileName = opt.getRegionsFile();
+    if ( !regionsFileName.empty() && !regions.load(regionsFileName) ) {
+        std::cout << "Cannot read the regions file " << regionsFileName << "! Exiting..." << std::endl;
+        exit(1);
+    }
+    bool perRegion = !regionsFileName.empty() || opt.detectLoops();
+
+    std::string traceFileName = opt.getTraceFile();
+    outputFileName = opt.getOutFile();
+
+    std::cout << "########################################" << std::endl;
+    std::cout << "#          SUMMARY                     #" << std::endl;
+    std::cout << "########################################" << std::endl;
+    std::cout << "# Vector length:         " << opt.getVectorLength() << " bits" << std::endl;
+    std::cout << "# Lane sizes:            " << laneSizes << (opt.isQuad() ? " (up to quad)" : " (up to double)") << std::endl;
+    std::cout << "# Meminstrace file:      " << traceFileName << std::endl;
+    std::cout << "# Output:                " << (outputFileName.empty() ? "stdout" : outputFileName) << std::endl;
+    std::cout << "# Fallback decoder:      " << (llvmMc.empty() ? "none" : llvmMc) << std::endl;
+    std::cout << "# Decode cache:          " << (cacheFileName.empty() ? "none" : cacheFileName);
+    if ( !cacheFileName.empty() ) {
+        std::cout << " (" << decodeCache->getLoaded() << " entries)";
+    }
+    std::cout << std::endl;
+    std::cout << "# Regions:               " << (regionsFileName.empty() ? "" : regionsFileName)
+              << (!regionsFileName.empty() && opt.detectLoops() ? " + " : "") << (opt.detectLoops() ? "loops" : "")
+              << (perRegion ? "" : "none") << std::endl;
+#ifdef ENABLE_GZIP
+    std::cout << "# Zipped files:          " << (opt.isZipped() ? "YES" : "NO") << std::endl;
+#endif
+    std::cout << "########################################" << std::endl;
+
+    /*
+     * First of all, open files
+     */
+    std::ifstream traceFile(traceFileName, std::ios_base::in | std::ios_base::binary);
+#ifdef ENABLE_GZIP
+    boost::iostreams::filtering_istream zippedTrace;
+    if ( opt.isZipped() ) {
+        zippedTrace.push(boost::iostreams::gzip_decompressor());
+        zippedTrace.push(traceFile);
+    }
+    std::istream &is = opt.isZipped() ? static_cast<std::istream &>(zippedTrace) : traceFile;
+#else
+    std::istream &is = traceFile;
+#endif
+    if ( !outputFileName.empty() ) {
+        outputFile = std::ofstream(outputFileName);
+    }
+
+    // Skip the header lines
+    std::string line;
+    bool more = static_cast<bool>(std::getline(is, line));
+    while ( more && (line.compare(0, 6, "Format") == 0 || line.compare(0, 8, "Instrace") == 0 ||
+                     line.compare(0, 8, "Memtrace") == 0) ) {
+        more = static_cast<bool>(std::getline(is, line));
+    }
+
+    /*
+     * Instrace lines (<PC>,<Opcode>,<isMem>) decode the instruction and add its FLOPs to the
+     * source registers. The memtrace lines (<TID>,<isBundle>,<isWrite>,<Size>,<Address>,<PC>)
+     * after a load update the FLOP/Byte of its destination register and count the bytes loaded
+     */
+    const signature *current = NULL;
+    pcCounters *currentStats = NULL;
+    unsigned long previousPc = 0;
+    unsigned int previousEncoding = 0;
+    bool isMemTrace = false;
+    const char *fields[6];
+    for ( ; more; more = static_cast<bool>(std::getline(is, line)) ) {
+        const char *str = line.c_str();
+        unsigned int numFields = 1;
+        fields[0] = str;
+        for ( const char *p = str; *p != '\0'; p++ ) {
+            if ( *p == ',' || *p == ';' ) {
+                if ( numFields < 6 ) {
+                    fields[numFields] = p + 1;
+                }
+                numFields++;
+            }
+        }
+
+        // Instrace lines
+        if ( numFields == 3 ) {
+            isMemTrace = false;
+            unsigned int encoding = std::strtoul(fields[1], NULL, 16);
+            bool isMem = std::strtol(fields[2], NULL, 10) != 0;
+
+            if ( perRegion ) {
+                unsigned long pc = std::strtoul(fields[0], NULL, 16);
+                currentStats = &pcStats[pc];
+                currentStats->instructions++;
+                if ( LoopTable::isBackwardTransfer(pc, previousPc, previousEncoding) ) {
+                    loops.addBackwardTransfer(pc, previousPc);
+                }
+                previousPc = pc;
+                previousEncoding = encoding;
+            }
+
+            const signature &sig = getSignature(encoding);
+            current = &sig;
+            if ( !sig.valid ) {
+                continue;
+            }
+
+            // If float instruction, increment #FLOPs of the source registers
+            if ( !isMem && sig.floating ) {
+                reportUndecoded(sig);
+                for ( unsigned int i = 0; i < sig.sources.size(); i++ ) {
+                    regs[sig.sources[i].first][sig.sources[i].second].flops += sig.weight;
+                }
+                if ( perRegion ) {
+                    currentStats->flops += sig.weight * sig.sources.size();
+                }
+            }
+            continue;
+        }
+
+        // Memtrace lines - Calculate bytes accessed
+        if ( numFields < 4 ) {
+            continue;
+        }
+        unsigned long size = std::strtoul(fields[3], NULL, 10);
+        if ( isMemTrace ) { // Part of the previous memory load instruction
+            regs[current->loadClass][current->loadIndex].bytes += size;
+            if ( perRegion ) {
+                currentStats->bytes += size;
+            }
+            continue;
+        }
+        // Only consider memory loads
+        if ( std::strtol(fields[2], NULL, 10) == 1 || current == NULL ) {
+            continue;
+        }
+        reportUndecoded(*current);
+        // Ignore the access if there is no destination register (e.g. prefetches, xzr)
+        if ( current->loadClass == NO_REG ) {
+            continue;
+        }
+
+        updateFlopsByte(current->loadClass, current->loadIndex);
+        if ( size != 0 ) { // All predicate lanes off (Empty LD) are ignored
+            isMemTrace = true;
+            regs[current->loadClass][current->loadIndex].bytes = size;
+            if ( perRegion ) {
+                currentStats->bytes += size;
+            }
+        }
+    }
+
+    /*
+     * Print a report
+     */
+    std::ostream &os = outputFileName.empty() ? std::cout : outputFile;
+    bool anyFlops = false;
+    for ( unsigned int i = 0; i < laneSizes; i++ ) {
+        anyFlops = anyFlops || flopsByteInv[i] != 0;
+    }
+    printTitle(os, "Floating Point Operations per Byte loaded");
+    if ( !anyFlops ) {
+        os << "No floating point operations were identified..." << std::endl;
+    } else {
+        printMeans(os);
+
+        // Do a last FLOP/Byte update on all registers
+        for ( int regClass = Z_REG; regClass < NO_REG; regClass++ ) {
+            for ( unsigned int i = 0; i < regRange[regClass]; i++ ) {
+                updateFlopsByte(regClass, i);
+            }
+        }
+        printTitle(os, "FLOP/Byte with update at the end");
+        printMeans(os);
+    }
+
+    if ( perRegion ) {
+        // One region per loop header, up to its last backward branch
+        if ( opt.detectLoops() ) {
+            char name[32];
+            loops.build();
+            for ( unsigned int i = 0; i < loops.size(); i++ ) {
+                snprintf(name, sizeof(name), "loop_0x%lx", loops[i].start);
+                regions.add(loops[i].start, loops[i].end, name);
+            }
+        }
+        printRegions(os, regions);
+    }
+
+    if ( !cacheFileName.empty() && !decodeCache->save(cacheFileName) ) {
+        std::cerr << "Warning: could not update the decode cache " << cacheFileName << std::endl;
+    }
+
+    if ( decodeCache->getLlvmFailures() != 0 ) {
+        std::cerr << "Warning: llvm-mc (" << llvmMc << ") failed on " << decodeCache->getLlvmFailures()
+                  << " encodings, which were not cached: " << decodeCache->getLlvmError() << std::endl;
+    }
+    if ( undecodedEncodings != 0 ) {
+        std::cerr << "Warning: " << undecodedEncodings << " floating point or load encodings are not covered by the "
+                  << "built-in decoder and were taken as having no register operands. "
+                  << (llvmMc.empty() ? "Set LLVM_MC to decode them with llvm-mc." : "Check LLVM_MC.") << std::endl;
+    }
+
+    if ( !outputFileName.empty() ) {
+        outputFile.close();
+    }
+    delete decodeCache;
+
+    return 0;
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+ 
+#ifndef OPTIONS_HPP
+#define OPTIONS_HPP
+
+#include <unistd.h>
+#include <iostream>
+
+class Options {
+    std::string outputFile;
+    std::string traceFile;
+    int concurrentThreads;
+    unsigned int counters;
+    unsigned int topEntries;
+    unsigned int lineSize;
+    unsigned int pageSize;
+#ifdef ENABLE_GZIP
+    bool zipped;
+#endif
+
+  public:
+    Options();
+    void readOptions(int argc, char *argv[]);
+
+    std::string getTraceFile();
+    std::string getOutFile();
+    int getConcurrentThreads();
+    unsigned int getCounters();
+    unsigned int getTopEntries();
+    unsigned int getLineSize();
+    unsigned int getPageSize();
+#ifdef ENABLE_GZIP
+    bool isZipped();
+#endif
+};
+
+#endif
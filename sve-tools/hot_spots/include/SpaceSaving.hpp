@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SPACESAVING_HPP
+#define SPACESAVING_HPP
+
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+
+/*
+ * Space-Saving heavy-hitters sketch (Metwally et al.)
+ *
+ * Keeps at most 'capacity' counters. An item that is not monitored replaces the
+ * item with the smallest counter and inherits its count, which is remembered as
+ * the maximum overestimation of the new item. Counters live in a min-heap, so an
+ * update costs O(log capacity) and the memory used never grows.
+ */
+class SpaceSaving {
+  public:
+    struct counter {
+        unsigned long key;
+        unsigned long count;
+        unsigned long error;
+    };
+
+  private:
+    unsigned int capacity;
+    std::vector<counter> heap;
+    // Key => position of the counter in the heap
+    std::unordered_map<unsigned long, unsigned int> position;
+
+    void swapCounters(unsigned int a, unsigned int b) {
+        std::swap(heap[a], heap[b]);
+        position[heap[a].key] = a;
+        position[heap[b].key] = b;
+    }
+
+    void siftUp(unsigned int i) {
+        while ( i > 0 && heap[(i - 1) / 2].count > heap[i].count ) {
+            swapCounters(i, (i - 1) / 2);
+            i = (i - 1) / 2;
+        }
+    }
+
+    void siftDown(unsigned int i) {
+        while ( true ) {
+            unsigned int smallest = i;
+            unsigned int left = 2 * i + 1;
+            unsigned int right = 2 * i + 2;
+            if ( left < heap.size() && heap[left].count < heap[smallest].count ) {
+                smallest = left;
+            }
+            if ( right < heap.size() && heap[right].count < heap[smallest].count ) {
+                smallest = right;
+            }
+            if ( smallest == i ) {
+                return;
+            }
+            swapCounters(i, smallest);
+            i = smallest;
+        }
+    }
+
+  public:
+    SpaceSaving(unsigned int capacity = 1) : capacity(capacity) {
+        heap.reserve(capacity);
+        position.reserve(capacity);
+    }
+
+    void update(unsigned long key, unsigned long increment = 1) {
+        std::unordered_map<unsigned long, unsigned int>::iterator iter = position.find(key);
+        if ( iter != position.end() ) {
+            heap[iter->second].count += increment;
+            siftDown(iter->second);
+        } else if ( heap.size() < capacity ) {
+            counter c = { key, increment, 0 };
+            heap.push_back(c);
+            position[key] = heap.size() - 1;
+            siftUp(heap.size() - 1);
+        } else {
+            // Evict the smallest counter, the new key inherits its count as error
+            position.erase(heap[0].key);
+            heap[0].error = heap[0].count;
+            heap[0].count += increment;
+            heap[0].key = key;
+            position[key] = 0;
+            siftDown(0);
+        }
+    }
+
+    // Any item that is not monitored has been seen at most this many times
+    unsigned long minCount() const {
+        if ( heap.size() < capacity ) {
+            return 0;
+        }
+        return heap[0].count;
+    }
+
+    const std::vector<counter> &counters() const {
+        return heap;
+    }
+
+    /*
+     * Merge several sketches (Agarwal et al., "Mergeable summaries"). An item missing
+     * from a full sketch may have been seen up to minCount() times there, so that
+     * amount is added both to its count and to its error. Returns the 'top' largest
+     * merged counters, largest first.
+     */
+    static std::vector<counter> merge(const std::vector<SpaceSaving> &sketches, unsigned int top) {
+        std::unordered_map<unsigned long, counter> merged;
+        unsigned long minSum = 0;
+        for ( unsigned int s = 0; s < sketches.size(); s++ ) {
+            minSum += sketches[s].minCount();
+        }
+        for ( unsigned int s = 0; s < sketches.size(); s++ ) {
+            const std::vector<counter> &sketchCounters = sketches[s].counters();
+            for ( unsigned int i = 0; i < sketchCounters.size(); i++ ) {
+                const counter &c = sketchCounters[i];
+                std::unordered_map<unsigned long, counter>::iterator iter = merged.find(c.key);
+                if ( iter == merged.end() ) {
+                    // Start with the bound of all the sketches, then swap this sketch's bound by its counter
+                    counter m = { c.key, minSum, minSum };
+                    iter = merged.insert(std::make_pair(c.key, m)).first;
+                }
+                iter->second.count += c.count - sketches[s].minCount();
+                iter->second.error += c.error - sketches[s].minCount();
+            }
+        }
+
+        std::vector<counter> result;
+        result.reserve(merged.size());
+        for ( std::unordered_map<unsigned long, counter>::iterator iter = merged.begin(); iter != merged.end(); iter++ ) {
+            result.push_back(iter->second);
+        }
+        std::sort(result.begin(), result.end(), [](const counter &a, const counter &b) {
+            return a.count > b.count || (a.count == b.count && a.key < b.key);
+        });
+        if ( result.size() > top ) {
+            result.resize(top);
+        }
+        return result;
+    }
+};
+
+#endif
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Options.hpp"
+
+/*
+ * Private functions
+ */
+void printUsage() {
+    std::cout << "hot_spots [OPTIONS] merged_memtrace_file" << std::endl;
+    exit(1);
+}
+
+void printHelp() {
+    std::cout << "hot_spots [OPTIONS] merged_memtrace_file" << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "\t-t <threads>     Specify how many threads to use for parallel processing (default: 1)" << std::endl;
+    std::cout << "\t-k <counters>    Counters kept by each sketch, bounds the memory used (default: 4096)" << std::endl;
+    std::cout << "\t-n <entries>     Number of hot lines, pages and PCs to report (default: 20)" << std::endl;
+    std::cout << "\t-l <bytes>       Cache line size, must be a power of two (default: 64)" << std::endl;
+    std::cout << "\t-p <bytes>       Page size, must be a power of two (default: 4096)" << std::endl;
+    std::cout << "\t-o <outputFile>  Redirect output to <outputFile> (default: stdout)" << std::endl;
+#ifdef ENABLE_GZIP
+    std::cout << "\t-z               Input files are zipped. Output will be zipped as well (default: no zip)" << std::endl;
+#endif
+    std::cout << "\t-h               Print this help" << std::endl;
+    exit(0);
+}
+
+bool isPowerOfTwo(unsigned int value) {
+    return value != 0 && (value & (value - 1)) == 0;
+}
+
+/*
+ * Public functions
+ */
+Options::Options() {
+    outputFile = std::string();
+    traceFile = std::string();
+    concurrentThreads = 1;
+    counters = 4096;
+    topEntries = 20;
+    lineSize = 64;
+    pageSize = 4096;
+#ifdef ENABLE_GZIP
+    zipped = false;
+#endif
+}
+
+void Options::readOptions(int argc, char *argv[]) {
+    int c;
+    int fileFounds = 0;
+    int optind2 = 1;
+    while ( optind2 < argc ) {
+#ifdef ENABLE_GZIP
+        if (( c = getopt(argc, argv, "t:k:n:l:p:o:zh")) != -1 ) {
+#else
+        if (( c = getopt(argc, argv, "t:k:n:l:p:o:h")) != -1 ) {
+#endif
+            switch(c) {
+                case 'o':
+                    optind2++;
+                    this->outputFile = std::string(argv[optind2]);
+                    optind2++;
+                    break;
+#ifdef ENABLE_GZIP
+                case 'z':
+                    this->zipped = true;
+                    optind2++;
+                    break;
+#endif
+                case 't':
+                    optind2++;
+                    this->concurrentThreads = std::stoi(argv[optind2]);
+                    optind2++;
+                    break;
+                case 'k':
+                    optind2++;
+                    this->counters = std::stoi(argv[optind2]);
+                    optind2++;
+                    break;
+                case 'n':
+                    optind2++;
+                    this->topEntries = std::stoi(argv[optind2]);
+                    optind2++;
+                    break;
+                case 'l':
+                    optind2++;
+                    this->lineSize = std::stoi(argv[optind2]);
+                    optind2++;
+                    break;
+                case 'p':
+                    optind2++;
+                    this->pageSize = std::stoi(argv[optind2]);
+                    optind2++;
+                    break;
+                case 'h':
+                    printHelp();
+                    break;
+                default:
+                    printUsage();
+                    break;
+            }
+        } else {
+            if ( fileFounds == 0 ) {
+                this->traceFile = std::string(argv[optind2]);
+                if ( access(this->traceFile.c_str(), F_OK) == -1 ) {
+                    std::cout << "Memory trace file not found! Exiting..." << std::endl;
+                    exit(1);
+                }
+
+                fileFounds++;
+            }
+            optind2++;
+        }
+    }
+    if ( fileFounds != 1 ) {
+        printUsage();
+    }
+    if ( concurrentThreads < 1 || counters == 0 ) {
+        printUsage();
+    }
+    if ( !isPowerOfTwo(lineSize) || !isPowerOfTwo(pageSize) ) {
+        std::cout << "Line and page sizes must be powers of two! Exiting..." << std::endl;
+        exit(1);
+    }
+}
+
+std::string Options::getTraceFile() {
+    return traceFile;
+}
+
+std::string Options::getOutFile() {
+    return outputFile;
+}
+
+int Options::getConcurrentThreads() {
+    return concurrentThreads;
+}
+
+unsigned int Options::getCounters() {
+    return counters;
+}
+
+unsigned int Options::getTopEntries() {
+    return topEntries;
+}
+
+unsigned int Options::getLineSize() {
+    return lineSize;
+}
+
+unsigned int Options::getPageSize() {
+    return pageSize;
+}
+
+#ifdef ENABLE_GZIP
+bool Options::isZipped() {
+    return zipped;
+}
+#endif
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Options.hpp"
+#include "Utils.hpp"
+#include "SpaceSaving.hpp"
+
+#include <fstream>
+#include <vector>
+#include <atomic>
+#include <iostream>
+#include <iomanip>
+
+#include <pthread.h>
+
+#define MIN_CHUNK_SIZE 10000
+
+std::string outputFileName;
+std::ofstream outputFile;
+std::vector< std::vector<std::string> > chunks;
+
+unsigned int lineBits;
+unsigned int pageBits;
+
+// One sketch of each kind per chunk. A chunk is only analyzed by one thread at a time,
+// so its sketches need no locking. They are merged once the whole trace is processed
+std::vector<SpaceSaving> lineSketches;
+std::vector<SpaceSaving> pageSketches;
+std::vector<SpaceSaving> pcSketches;
+
+std::atomic<unsigned long> totalLineAccesses;
+std::atomic<unsigned long> totalPageAccesses;
+std::atomic<unsigned long> totalInstructions;
+
+// Threaded analyzer
+void *analyzeChunk ( void *chunk ) {
+    int *aux = (int*) chunk;
+    int chunkToAnalyze = *aux;
+
+    SpaceSaving &lines = lineSketches[chunkToAnalyze];
+    SpaceSaving &pages = pageSketches[chunkToAnalyze];
+    SpaceSaving &pcs = pcSketches[chunkToAnalyze];
+
+    // Create local counters
+    unsigned long localLineAccesses = 0;
+    unsigned long localPageAccesses = 0;
+    unsigned long localInstructions = 0;
+
+    memRecord record;
+    for ( int i = 0; i < chunks[chunkToAnalyze].size(); i++ ) {
+        if ( !parseLine(chunks[chunkToAnalyze][i], record) ) {
+            continue;
+        }
+        // Gather/scatter elements are accesses on their own, but the instruction is counted once
+        if ( (record.isBundle & 0x3) != 0x2 ) {
+            pcs.update(record.pc);
+            localInstructions++;
+        }
+        if ( record.dataSize == 0 ) {
+            continue;
+        }
+
+        // Count every line and page touched by the access
+        unsigned long lastByte = record.dataAddress + record.dataSize - 1;
+        for ( unsigned long line = record.dataAddress >> lineBits; line <= (lastByte >> lineBits); line++ ) {
+            lines.update(line);
+            localLineAccesses++;
+        }
+        for ( unsigned long page = record.dataAddress >> pageBits; page <= (lastByte >> pageBits); page++ ) {
+            pages.update(page);
+            localPageAccesses++;
+        }
+    }
+
+    // Update global counters
+    totalLineAccesses += localLineAccesses;
+    totalPageAccesses += localPageAccesses;
+    totalInstructions += localInstructions;
+
+    pthread_exit(NULL);
+}
+
+void printTable ( std::ostream &os, const std::string &header, const std::vector<SpaceSaving> &sketches,
+                  unsigned int top, unsigned int shift, unsigned long total ) {
+    std::vector<SpaceSaving::counter> hottest = SpaceSaving::merge(sketches, top);
+
+    os << header << ",estimated count,max. overestimation,\%total" << std::endl;
+    for ( unsigned int i = 0; i < hottest.size(); i++ ) {
+        os << "0x" << std::hex << (hottest[i].key << shift) << std::dec << "," << hottest[i].count << ","
+           << hottest[i].error << "," << (total ? ((double)hottest[i].count / (double)total) * 100 : 0.0) << std::endl;
+    }
+}
+
+int main (int argc, char *argv[]) {
+    Options opt;
+    opt.readOptions(argc, argv);
+
+    int concurrentThreads = opt.getConcurrentThreads();
+
+    lineBits = 0;
+    while ( (1U << lineBits) < opt.getLineSize() ) {
+        lineBits++;
+    }
+    pageBits = 0;
+    while ( (1U << pageBits) < opt.getPageSize() ) {
+        pageBits++;
+    }
+
+    pthread_t analyzeThreads[concurrentThreads];
+    int chunkInUse = 0;
+
+    totalLineAccesses = 0;
+    totalPageAccesses = 0;
+    totalInstructions = 0;
+
+    chunks = std::vector< std::vector<std::string> >(concurrentThreads);
+    lineSketches = std::vector<SpaceSaving>(concurrentThreads, SpaceSaving(opt.getCounters()));
+    pageSketches = std::vector<SpaceSaving>(concurrentThreads, SpaceSaving(opt.getCounters()));
+    pcSketches = std::vector<SpaceSaving>(concurrentThreads, SpaceSaving(opt.getCounters()));
+
+    std::vector<bool> runningChunk(concurrentThreads, false);
+    std::vector<int> chunkIds(concurrentThreads);
+    for ( int i = 0; i < concurrentThreads; i++ ) {
+        chunkIds[i] = i;
+    }
+
+    std::string traceFileName = opt.getTraceFile();
+    outputFileName = opt.getOutFile();
+
+    std::cout << "########################################" << std::endl;
+    std::cout << "#          SUMMARY                     #" << std::endl;
+    std::cout << "########################################" << std::endl;
+    std::cout << "# Line size:             " << opt.getLineSize() << " bytes" << std::endl;
+    std::cout << "# Page size:             " << opt.getPageSize() << " bytes" << std::endl;
+    std::cout << "# Counters per sketch:   " << opt.getCounters() << std::endl;
+    std::cout << "# Memtrace file:         " << traceFileName << std::endl;
+    std::cout << "# Output:                " << (outputFileName.empty() ? "stdout" : outputFileName) << std::endl;
+#ifdef ENABLE_GZIP
+    std::cout << "# Zipped files:          " << (opt.isZipped() ? "YES" : "NO") << std::endl;
+#endif
+    std::cout << "########################################" << std::endl;
+
+    /*
+     * First of all, open files
+     */
+    std::ifstream traceFile(traceFileName);
+    if ( !outputFileName.empty() ) {
+        outputFile = std::ofstream(outputFileName);
+    }
+
+    std::string line;
+    std::vector<std::string> chunkContents;
+    chunkContents.clear();
+
+    int typeOfLine;
+    typeOfLine = readLine(traceFile, line);
+    while ( typeOfLine != END_OF_FILE ) {
+        // Every access counts on its own, so bundles do not need to be kept together
+        chunkContents.push_back(line);
+        typeOfLine = readLine(traceFile, line);
+
+        /*
+         * If we've completed a chunk, spawn a thread to process it
+         */
+        if ( chunkContents.size() >= MIN_CHUNK_SIZE ) {
+            if ( runningChunk[chunkInUse] ) { // if the thread is running, wait for it
+                pthread_join( analyzeThreads[chunkInUse], NULL);
+            }
+            chunks[chunkInUse].swap(chunkContents);
+            chunkContents.clear();
+            // Spawn an analysis thread
+            pthread_create(&analyzeThreads[chunkInUse], NULL, analyzeChunk, (void*) &chunkIds[chunkInUse]);
+            runningChunk[chunkInUse] = true;
+            chunkInUse++;
+            if ( chunkInUse == concurrentThreads ) {
+                chunkInUse = 0;
+            }
+        }
+    }
+
+    // Check if we reach EOF before filling a chunk
+    if ( runningChunk[chunkInUse] ) {
+        pthread_join( analyzeThreads[chunkInUse], NULL);
+    }
+    chunks[chunkInUse].swap(chunkContents);
+    pthread_create(&analyzeThreads[chunkInUse], NULL, analyzeChunk, (void*) &chunkIds[chunkInUse]);
+    runningChunk[chunkInUse] = true;
+
+    // Need to wait for all the threads to finish now
+    for ( int i = 0; i < concurrentThreads; i++ ) {
+        if ( runningChunk[i] ) {
+            pthread_join(analyzeThreads[i], NULL);
+        }
+        runningChunk[i] = false;
+    }
+
+    /*
+     * Print a report
+     */
+    std::ostream &os = outputFileName.empty() ? std::cout : outputFile;
+    os << std::fixed;
+    os << std::setprecision(4);
+    os << "Line accesses           = " << totalLineAccesses << std::endl;
+    os << "Page accesses           = " << totalPageAccesses << std::endl;
+    os << "Memory instructions     = " << totalInstructions << std::endl;
+    os << std::endl;
+    printTable(os, "line address", lineSketches, opt.getTopEntries(), lineBits, totalLineAccesses);
+    os << std::endl;
+    printTable(os, "page address", pageSketches, opt.getTopEntries(), pageBits, totalPageAccesses);
+    os << std::endl;
+    printTable(os, "PC", pcSketches, opt.getTopEntries(), 0, totalInstructions);
+
+    traceFile.close();
+    if ( !outputFileName.empty() ) {
+        outputFile.close();
+    }
+
+    return 0;
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CLASSIFIER_HPP
+#define CLASSIFIER_HPP
+
+/*
+ * Major opcode groups of AArch64 and SVE instructions, from the encoding alone
+ *
+ * SVE is the op0 = 0010 class of the top-level decode. SVE groups follow the
+ * SVE encoding index: floating-point (op0 = 011), memory (op0 = 1xx), permutes
+ * (op0 = 000, bits 24 and 21 set), predicate operations and integer compares
+ * (op0 = 001, except the wide immediates), and integer for the rest. AArch64
+ * instructions use the top-level classes, with the Advanced SIMD permutes and
+ * the floating-point forms of the Advanced SIMD groups split out.
+ */
+enum instrGroup { LOAD_STORE, FP, INTEGER, PREDICATE, PERMUTE, BRANCH, OTHER, NUM_GROUPS };
+
+static const char *GROUP_NAMES[NUM_GROUPS] = {
+    "load/store", "fp", "integer", "predicate", "permute", "branch", "other"
+};
+
+inline bool isSve(unsigned int e) {
+    return ((e >> 25) & 0xF) == 0x2;
+}
+
+inline int classifySve(unsigned int e) {
+    // fcpy, fdup, ftssel, fexpa and the predicated fabs/fneg sit among the integer encodings
+    if ( (e & 0xFF30E000) == 0x0510C000 || (e & 0xFF3FE000) == 0x2539C000 || (e & 0xFF20FC00) == 0x0420B000 ||
+         (e & 0xFF3FFC00) == 0x0420B800 || (e & 0xFF3EE000) == 0x041CA000 ) {
+        return FP;
+    }
+    switch ( e >> 29 ) {
+        case 0:
+            return ((e & 0x01200000) == 0x01200000) ? PERMUTE : INTEGER;
+        case 1:
+            // Wide immediates (add, mul, dup, fdup...) share the predicate space
+            return ((e & 0x0120C000) == 0x0120C000) ? INTEGER : PREDICATE;
+        case 2:
+            return INTEGER;
+        case 3:
+            return FP;
+        default:
+            return LOAD_STORE;
+    }
+}
+
+// Advanced SIMD, scalar and vector forms
+inline int classifyAdvSimd(unsigned int e) {
+    // zip/uzp/trn, tbl/tbx, ext, dup/ins/umov/smov
+    if ( (e & 0xBF208C00) == 0x0E000800 || (e & 0xBF208C00) == 0x0E000000 || (e & 0xBFE08400) == 0x2E000000 ||
+         (e & 0x9FE08400) == 0x0E000400 || (e & 0xDFE08400) == 0x5E000400 ) {
+        return PERMUTE;
+    }
+    // Three same: floating-point opcodes are 11xxx, and the half-precision group
+    if ( (e & 0x0F200400) == 0x0E200400 ) {
+        return ((e >> 14) & 0x3) == 0x3 ? FP : INTEGER;
+    }
+    if ( (e & 0x0F60C400) == 0x0E400400 ) {
+        return FP;
+    }
+    // Three same extra: fcmla, fcadd and the BFloat16 forms are U = 1 with opcodes 1xxx
+    if ( (e & 0x9F208400) == 0x0E008400 ) {
+        return ((e & 0x20000000) && (e & 0x00004000)) ? FP : INTEGER;
+    }
+    // Two-register misc, half-precision included, and across lanes or pairwise
+    if ( (e & 0x0F7E0C00) == 0x0E780800 ) {
+        return FP;
+    }
+    if ( (e & 0x0F3E0C00) == 0x0E200800 ) {
+        unsigned int opcode = (e >> 12) & 0x1F;
+        if ( opcode == 0x1C && (e & 0x00800000) ) { // urecpe, ursqrte
+            return INTEGER;
+        }
+        return (opcode >= 0x16 || (opcode >= 0x0C && opcode <= 0x0F)) ? FP : INTEGER;
+    }
+    if ( (e & 0x0F3E0C00) == 0x0E300800 ) {
+        unsigned int opcode = (e >> 12) & 0x1F;
+        return (opcode >= 0x0C && opcode <= 0x0F) ? FP : INTEGER;
+    }
+    // By element: fmla, fmls, fmul(x), fcmla, fmlal(2)/fmlsl(2) and the BFloat16 dot products
+    if ( (e & 0x0F000400) == 0x0F000000 ) {
+        unsigned int opcode = (e >> 12) & 0xF;
+        unsigned int size = (e >> 22) & 0x3;
+        bool u = (e >> 29) & 1;
+        if ( opcode == 0x1 || opcode == 0x5 || opcode == 0x9 || (u && (opcode & 0x9) == 0x1) ) {
+            return FP;
+        }
+        if ( (size == 0x2 && (opcode & 0xB) == (u ? 0x8 : 0x0)) || (!u && opcode == 0xF && (size & 0x1)) ) {
+            return FP;
+        }
+        return INTEGER;
+    }
+    // Modified immediate (fmov) and shifts by immediate (fixed-point conversions)
+    if ( (e & 0x0FF80400) == 0x0F000400 ) {
+        return ((e >> 12) & 0xF) == 0xF ? FP : INTEGER;
+    }
+    if ( (e & 0x0F800400) == 0x0F000400 ) {
+        unsigned int opcode = (e >> 11) & 0x1F;
+        return (opcode == 0x1C || opcode == 0x1F) ? FP : INTEGER;
+    }
+    return INTEGER;
+}
+
+inline int classify(unsigned int e) {
+    if ( isSve(e) ) {
+        return classifySve(e);
+    }
+    unsigned int op0 = (e >> 25) & 0xF;
+    if ( (op0 & 0xE) == 0x8 ) {              // 100x, data processing - immediate
+        return INTEGER;
+    }
+    if ( (op0 & 0xE) == 0xA ) {              // 101x, branches, exceptions and system
+        if ( (e & 0xFF000010) == 0x54000000 || (e & 0x7C000000) == 0x14000000 ||
+             (e & 0x7C000000) == 0x34000000 || (e & 0xFE000000) == 0xD6000000 ) {
+            return BRANCH;
+        }
+        return OTHER;
+    }
+    if ( (op0 & 0x5) == 0x4 ) {              // x1x0, loads and stores
+        return LOAD_STORE;
+    }
+    if ( (op0 & 0x7) == 0x5 ) {              // x101, data processing - register
+        return INTEGER;
+    }
+    if ( (op0 & 0x7) == 0x7 ) {              // x111, scalar floating-point and Advanced SIMD
+        if ( (e & 0x5E000000) == 0x1E000000 ) {
+            return FP;
+        }
+        if ( (e & 0x9E000000) == 0x0E000000 || (e & 0xDE000000) == 0x5E000000 ) {
+            return classifyAdvSimd(e);
+        }
+        return OTHER;                        // crypto
+    }
+    return OTHER;
+}
+
+#endif
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Options.hpp"
+
+/*
+ * Private functions
+ */
+void printUsage() {
+    std::cout << "inst_mix [OPTIONS] instrace_file" << std::endl;
+    exit(1);
+}
+
+void printHelp() {
+    std::cout << "inst_mix [OPTIONS] instrace_file" << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "\t-t <threads>     Specify how many threads to use for parallel processing (default: 1)" << std::endl;
+    std::cout << "\t-n <entries>     Number of hot PCs to report (default: 20)" << std::endl;
+    std::cout << "\t-r <regionsFile> Report the mix per region, one \"start,end,name\" range per line" << std::endl;
+    std::cout << "\t-l               Report the mix per loop, detected from backward transfers" << std::endl;
+    std::cout << "\t-o <outputFile>  Redirect output to <outputFile> (default: stdout)" << std::endl;
+#ifdef ENABLE_GZIP
+    std::cout << "\t-z               Input file is zipped (default: no zip)" << std::endl;
+#endif
+    std::cout << "\t-h               Print this help" << std::endl;
+    exit(0);
+}
+
+/*
+ * Public functions
+ */
+Options::Options() {
+    outputFile = std::string();
+    traceFile = std::string();
+    regionsFile = std::string();
+    concurrentThreads = 1;
+    topEntries = 20;
+    loops = false;
+#ifdef ENABLE_GZIP
+    zipped = false;
+#endif
+}
+
+void Options::readOptions(int argc, char *argv[]) {
+    int c;
+    int fileFounds = 0;
+    int optind2 = 1;
+    while ( optind2 < argc ) {
+#ifdef ENABLE_GZIP
+        if (( c = getopt(argc, argv, "t:n:r:lo:zh")) != -1 ) {
+#else
+        if (( c = getopt(argc, argv, "t:n:r:lo:h")) != -1 ) {
+#endif
+            switch(c) {
+                case 'o':
+                    optind2++;
+                    this->outputFile = std::string(argv[optind2]);
+                    optind2++;
+                    break;
+#ifdef ENABLE_GZIP
+                case 'z':
+                    this->zipped = true;
+                    optind2++;
+                    break;
+#endif
+                case 't':
+                    optind2++;
+                    this->concurrentThreads = std::stoi(argv[optind2]);
+                    optind2++;
+                    break;
+                case 'n':
+                    optind2++;
+                    this->topEntries = std::stoi(argv[optind2]);
+                    optind2++;
+                    break;
+                case 'r':
+                    optind2++;
+                    this->regionsFile = std::string(argv[optind2]);
+                    optind2++;
+                    break;
+                case 'l':
+                    this->loops = true;
+                    optind2++;
+                    break;
+                case 'h':
+                    printHelp();
+                    break;
+                default:
+                    printUsage();
+                    break;
+            }
+        } else {
+            if ( fileFounds == 0 ) {
+                this->traceFile = std::string(argv[optind2]);
+                if ( access(this->traceFile.c_str(), F_OK) == -1 ) {
+                    std::cout << "Instruction trace file not found! Exiting..." << std::endl;
+                    exit(1);
+                }
+
+                fileFounds++;
+            }
+            optind2++;
+        }
+    }
+    if ( fileFounds != 1 ) {
+        printUsage();
+    }
+    if ( concurrentThreads < 1 ) {
+        printUsage();
+    }
+}
+
+std::string Options::getTraceFile() {
+    return traceFile;
+}
+
+std::string Options::getOutFile() {
+    return outputFile;
+}
+
+std::string Options::getRegionsFile() {
+    return regionsFile;
+}
+
+int Options::getConcurrentThreads() {
+    return concurrentThreads;
+}
+
+unsigned int Options::getTopEntries() {
+    return topEntries;
+}
+
+bool Options::detectLoops() {
+    return loops;
+}
+
+#ifdef ENABLE_GZIP
+bool Options::isZipped() {
+    return zipped;
+}
+#endif
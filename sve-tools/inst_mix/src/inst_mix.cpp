@@ -0,0 +1,415 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Options.hpp"
+#include "Classifier.hpp"
+#include "Regions.hpp"
+#include "LoopTable.hpp"
+
+#include <fstream>
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <atomic>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <cstdio>
+#include <cstdlib>
+
+#include <pthread.h>
+
+#ifdef ENABLE_GZIP
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#endif
+
+#define MIN_CHUNK_SIZE 10000
+
+// Executions of a PC and its encoding, which gives the group
+struct pcRecord {
+    unsigned long count;
+    unsigned int encoding;
+};
+
+// What a thread gathers from the chunks it analyzes. A chunk is only analyzed by one
+// thread at a time, so no locking is needed; everything is merged once the trace is processed
+struct chunkStats {
+    std::unordered_map<unsigned long, pcRecord> pcs;
+    LoopTable loops;
+    // First and last PC of the last chunk, to find the backward transfers across chunks
+    unsigned long firstPc;
+    unsigned long lastPc;
+    unsigned int lastEncoding;
+    bool empty;
+};
+
+std::string outputFileName;
+std::ofstream outputFile;
+std::vector< std::vector<std::string> > chunks;
+std::vector<chunkStats> stats;
+
+// Instructions of every group, SVE (1) or aarch64 (0)
+std::atomic<unsigned long> groupCounts[NUM_GROUPS][2];
+
+/*
+ * Instrace lines are <PC>,<Opcode>,<isMem>. ArmIE writes the emulated (SVE) instructions with ';'
+ * and the native ones with ','; the encoding tells them apart anyway. Every other line (headers,
+ * memtrace lines of a merged meminstrace) is skipped.
+ */
+bool parseInstrace ( const std::string &line, unsigned long &pc, unsigned int &encoding ) {
+    const char *str = line.c_str();
+    char *end;
+    pc = std::strtoul(str, &end, 16);
+    if ( end == str || (*end != ',' && *end != ';') ) {
+        return false;
+    }
+    str = end + 1;
+    encoding = std::strtoul(str, &end, 16);
+    if ( end == str || (*end != ',' && *end != ';') ) {
+        return false;
+    }
+    str = end + 1;
+    std::strtoul(str, &end, 10);
+    return end != str && *end == '\0';
+}
+
+// Threaded analyzer
+void *analyzeChunk ( void *chunk ) {
+    int *aux = (int*) chunk;
+    int chunkToAnalyze = *aux;
+
+    chunkStats &local = stats[chunkToAnalyze];
+    local.empty = true;
+
+    // Create local counters
+    unsigned long localGroups[NUM_GROUPS][2] = {};
+
+    unsigned long pc;
+    unsigned long previousPc = 0;
+    unsigned int encoding;
+    unsigned int previousEncoding = 0;
+    for ( unsigned int i = 0; i < chunks[chunkToAnalyze].size(); i++ ) {
+        if ( !parseInstrace(chunks[chunkToAnalyze][i], pc, encoding) ) {
+            continue;
+        }
+        localGroups[classify(encoding)][isSve(encoding)]++;
+
+        pcRecord &record = local.pcs[pc];
+        record.count++;
+        record.encoding = encoding;
+
+        if ( local.empty ) {
+            local.firstPc = pc;
+            local.empty = false;
+        } else if ( LoopTable::isBackwardTransfer(pc, previousPc, previousEncoding) ) {
+            local.loops.addBackwardTransfer(pc, previousPc);
+        }
+        previousPc = pc;
+        previousEncoding = encoding;
+    }
+    local.lastPc = previousPc;
+    local.lastEncoding = previousEncoding;
+
+    // Update global counters
+    for ( int i = 0; i < NUM_GROUPS; i++ ) {
+        groupCounts[i][0] += localGroups[i][0];
+        groupCounts[i][1] += localGroups[i][1];
+    }
+
+    pthread_exit(NULL);
+}
+
+/*
+ * Chunks are joined in the order they were read, so the transfer between the last PC of a chunk
+ * and the first PC of the next one can be checked as they finish
+ */
+LoopTable loops;
+unsigned long lastChunkPc;
+unsigned int lastChunkEncoding;
+bool anyChunk = false;
+
+void joinChunk ( pthread_t thread, int chunk ) {
+    pthread_join(thread, NULL);
+    const chunkStats &local = stats[chunk];
+    if ( local.empty ) {
+        return;
+    }
+    if ( anyChunk && LoopTable::isBackwardTransfer(local.firstPc, lastChunkPc, lastChunkEncoding) ) {
+        loops.addBackwardTransfer(local.firstPc, lastChunkPc);
+    }
+    lastChunkPc = local.lastPc;
+    lastChunkEncoding = local.lastEncoding;
+    anyChunk = true;
+}
+
+struct mixRow {
+    unsigned long groups[NUM_GROUPS][2];
+};
+
+bool moreExecuted ( const std::pair<unsigned long, pcRecord> &a, const std::pair<unsigned long, pcRecord> &b ) {
+    if ( a.second.count != b.second.count ) {
+        return a.second.count > b.second.count;
+    }
+    return a.first < b.first;
+}
+
+bool moreInstructions ( const std::pair<unsigned int, unsigned long> &a, const std::pair<unsigned int, unsigned long> &b ) {
+    return a.second > b.second;
+}
+
+double percentage ( unsigned long part, unsigned long total ) {
+    return total ? ((double)part / (double)total) * 100 : 0.0;
+}
+
+/*
+ * Instruction mix of every region, a PC counting for the innermost region that contains it
+ */
+void printRegions ( std::ostream &os, Regions &regions, const std::unordered_map<unsigned long, pcRecord> &pcs ) {
+    std::vector<mixRow> rows(regions.size() + 1, mixRow());
+    for ( std::unordered_map<unsigned long, pcRecord>::const_iterator it = pcs.begin(); it != pcs.end(); it++ ) {
+        int i = regions.find(it->first);
+        mixRow &row = rows[i < 0 ? regions.size() : i];
+        row.groups[classify(it->second.encoding)][isSve(it->second.encoding)] += it->second.count;
+    }
+
+    // Sort the regions by instructions, leaving "other" at the end
+    std::vector< std::pair<unsigned int, unsigned long> > order(regions.size() + 1);
+    for ( unsigned int i = 0; i <= regions.size(); i++ ) {
+        unsigned long total = 0;
+        for ( int j = 0; j < NUM_GROUPS; j++ ) {
+            total += rows[i].groups[j][0] + rows[i].groups[j][1];
+        }
+        order[i] = std::make_pair(i, total);
+    }
+    std::stable_sort(order.begin(), order.end() - 1, moreInstructions);
+
+    char buffer[64];
+    os << "region,start,end,instructions,SVE,aarch64,\%SVE";
+    for ( int j = 0; j < NUM_GROUPS; j++ ) {
+        os << "," << GROUP_NAMES[j];
+    }
+    os << std::endl;
+    for ( unsigned int k = 0; k < order.size(); k++ ) {
+        unsigned int i = order[k].first;
+        unsigned long total = order[k].second;
+        if ( total == 0 ) {
+            continue;
+        }
+        unsigned long sveInstructions = 0;
+        for ( int j = 0; j < NUM_GROUPS; j++ ) {
+            sveInstructions += rows[i].groups[j][1];
+        }
+        if ( i < regions.size() ) {
+            snprintf(buffer, sizeof(buffer), ",0x%lx,0x%lx", regions[i].start, regions[i].end);
+            os << regions[i].name << buffer;
+        } else {
+            os << "other,,";
+        }
+        os << "," << total << "," << sveInstructions << "," << total - sveInstructions << ","
+           << percentage(sveInstructions, total);
+        for ( int j = 0; j < NUM_GROUPS; j++ ) {
+            os << "," << rows[i].groups[j][0] + rows[i].groups[j][1];
+        }
+        os << std::endl;
+    }
+}
+
+int main (int argc, char *argv[]) {
+    Options opt;
+    opt.readOptions(argc, argv);
+
+    int concurrentThreads = opt.getConcurrentThreads();
+
+    pthread_t analyzeThreads[concurrentThreads];
+    int chunkInUse = 0;
+
+    for ( int i = 0; i < NUM_GROUPS; i++ ) {
+        groupCounts[i][0] = 0;
+        groupCounts[i][1] = 0;
+    }
+
+    chunks = std::vector< std::vector<std::string> >(concurrentThreads);
+    stats = std::vector<chunkStats>(concurrentThreads);
+
+    std::vector<bool> runningChunk(concurrentThreads, false);
+    std::vector<int> chunkIds(concurrentThreads);
+    for ( int i = 0; i < concurrentThreads; i++ ) {
+        chunkIds[i] = i;
+    }
+
+    std::string traceFileName = opt.getTraceFile();
+    outputFileName = opt.getOutFile();
+
+    // Regions from a file and/or the loops found in the trace
+    Regions regions;
+    std::string regionsFileName = opt.getRegionsFile();
+    if ( !regionsFileName.empty() && !regions.load(regionsFileName) ) {
+        std::cout << "Cannot read the regions file " << regionsFileName << "! Exiting..." << std::endl;
+        exit(1);
+    }
+    bool perRegion = !regionsFileName.empty() || opt.detectLoops();
+
+    std::cout << "########################################" << std::endl;
+    std::cout << "#          SUMMARY                     #" << std::endl;
+    std::cout << "########################################" << std::endl;
+    std::cout << "# Instrace file:         " << traceFileName << std::endl;
+    std::cout << "# Output:                " << (outputFileName.empty() ? "stdout" : outputFileName) << std::endl;
+    std::cout << "# Regions:               " << (regionsFileName.empty() ? "" : regionsFileName)
+              << (!regionsFileName.empty() && opt.detectLoops() ? " + " : "") << (opt.detectLoops() ? "loops" : "")
+              << (perRegion ? "" : "none") << std::endl;
+#ifdef ENABLE_GZIP
+    std::cout << "# Zipped files:          " << (opt.isZipped() ? "YES" : "NO") << std::endl;
+#endif
+    std::cout << "########################################" << std::endl;
+
+    /*
+     * First of all, open files
+     */
+    std::ifstream traceFile(traceFileName, std::ios_base::in | std::ios_base::binary);
+#ifdef ENABLE_GZIP
+    boost::iostreams::filtering_istream zippedTrace;
+    if ( opt.isZipped() ) {
+        zippedTrace.push(boost::iostreams::gzip_decompressor());
+        zippedTrace.push(traceFile);
+    }
+    std::istream &is = opt.isZipped() ? static_cast<std::istream &>(zippedTrace) : traceFile;
+#else
+    std::istream &is = traceFile;
+#endif
+    if ( !outputFileName.empty() ) {
+        outputFile = std::ofstream(outputFileName);
+    }
+
+    std::string line;
+    std::vector<std::string> chunkContents;
+    chunkContents.clear();
+
+    while ( std::getline(is, line) ) {
+        chunkContents.push_back(line);
+
+        /*
+         * If we've completed a chunk, spawn a thread to process it
+         */
+        if ( chunkContents.size() >= MIN_CHUNK_SIZE ) {
+            if ( runningChunk[chunkInUse] ) { // if the thread is running, wait for it
+                joinChunk(analyzeThreads[chunkInUse], chunkInUse);
+            }
+            chunks[chunkInUse].swap(chunkContents);
+            chunkContents.clear();
+            // Spawn an analysis thread
+            pthread_create(&analyzeThreads[chunkInUse], NULL, analyzeChunk, (void*) &chunkIds[chunkInUse]);
+            runningChunk[chunkInUse] = true;
+            chunkInUse++;
+            if ( chunkInUse == concurrentThreads ) {
+                chunkInUse = 0;
+            }
+        }
+    }
+
+    // Check if we reach EOF before filling a chunk
+    if ( runningChunk[chunkInUse] ) {
+        joinChunk(analyzeThreads[chunkInUse], chunkInUse);
+    }
+    chunks[chunkInUse].swap(chunkContents);
+    pthread_create(&analyzeThreads[chunkInUse], NULL, analyzeChunk, (void*) &chunkIds[chunkInUse]);
+    runningChunk[chunkInUse] = true;
+
+    // Need to wait for all the threads to finish now, oldest chunk first
+    for ( int i = 1; i <= concurrentThreads; i++ ) {
+        int chunk = (chunkInUse + i) % concurrentThreads;
+        if ( runningChunk[chunk] ) {
+            joinChunk(analyzeThreads[chunk], chunk);
+        }
+        runningChunk[chunk] = false;
+    }
+
+    /*
+     * Merge the per-thread statistics
+     */
+    std::unordered_map<unsigned long, pcRecord> pcs;
+    for ( int i = 0; i < concurrentThreads; i++ ) {
+        for ( std::unordered_map<unsigned long, pcRecord>::iterator it = stats[i].pcs.begin(); it != stats[i].pcs.end(); it++ ) {
+            pcRecord &record = pcs[it->first];
+            record.count += it->second.count;
+            record.encoding = it->second.encoding;
+        }
+        loops.merge(stats[i].loops);
+    }
+
+    unsigned long sveInstructions = 0;
+    unsigned long aarch64Instructions = 0;
+    for ( int i = 0; i < NUM_GROUPS; i++ ) {
+        aarch64Instructions += groupCounts[i][0];
+        sveInstructions += groupCounts[i][1];
+    }
+    unsigned long totalInstructions = sveInstructions + aarch64Instructions;
+
+    /*
+     * Print a report
+     */
+    std::ostream &os = outputFileName.empty() ? std::cout : outputFile;
+    os << std::fixed;
+    os << std::setprecision(4);
+    os << "Instructions            = " << totalInstructions << std::endl;
+    os << "SVE instructions        = " << sveInstructions << std::endl;
+    os << "Aarch64 instructions    = " << aarch64Instructions << std::endl;
+    os << "\%SVE                    = " << percentage(sveInstructions, totalInstructions) << std::endl;
+    os << std::endl;
+
+    os << "group,SVE,aarch64,total,\%total" << std::endl;
+    for ( int i = 0; i < NUM_GROUPS; i++ ) {
+        os << GROUP_NAMES[i] << "," << groupCounts[i][1] << "," << groupCounts[i][0] << ","
+           << groupCounts[i][1] + groupCounts[i][0] << ","
+           << percentage(groupCounts[i][1] + groupCounts[i][0], totalInstructions) << std::endl;
+    }
+    os << std::endl;
+
+    std::vector< std::pair<unsigned long, pcRecord> > hottest(pcs.begin(), pcs.end());
+    unsigned int top = std::min((size_t)opt.getTopEntries(), hottest.size());
+    std::partial_sort(hottest.begin(), hottest.begin() + top, hottest.end(), moreExecuted);
+    os << "PC,encoding,group,type,count,\%total" << std::endl;
+    char buffer[64];
+    for ( unsigned int i = 0; i < top; i++ ) {
+        unsigned int encoding = hottest[i].second.encoding;
+        snprintf(buffer, sizeof(buffer), "0x%lx,0x%08x,", hottest[i].first, encoding);
+        os << buffer << GROUP_NAMES[classify(encoding)] << "," << (isSve(encoding) ? "SVE" : "aarch64") << ","
+           << hottest[i].second.count << "," << percentage(hottest[i].second.count, totalInstructions) << std::endl;
+    }
+
+    if ( perRegion ) {
+        // One region per loop header, up to its last backward branch
+        if ( opt.detectLoops() ) {
+            char name[32];
+            loops.build();
+            for ( unsigned int i = 0; i < loops.size(); i++ ) {
+                snprintf(name, sizeof(name), "loop_0x%lx", loops[i].start);
+                regions.add(loops[i].start, loops[i].end, name);
+            }
+        }
+        os << std::endl;
+        printRegions(os, regions, pcs);
+    }
+
+    traceFile.close();
+    if ( !outputFileName.empty() ) {
+        outputFile.close();
+    }
+
+    return 0;
+}
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Options.hpp"
+
+/*
+ * Private functions
+ */
+void printUsage() {
+    std::cout << "loops [OPTIONS] instrace_file" << std::endl;
+    exit(1);
+}
+
+void printHelp() {
+    std::cout << "loops [OPTIONS] instrace_file" << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "\t-a <memtraceFile>  Annotate a merged memtrace with the loop ID of every access" << std::endl;
+    std::cout << "\t-m <annotatedFile> Write the annotated memtrace to <annotatedFile> (default: <memtraceFile>.loops)" << std::endl;
+    std::cout << "\t-x <regionsFile>   Write the loops as a regions file (\"start,end,name\" lines)" << std::endl;
+    std::cout << "\t-o <outputFile>    Redirect output to <outputFile> (default: stdout)" << std::endl;
+#ifdef ENABLE_GZIP
+    std::cout << "\t-z                 Input files are zipped. The annotated memtrace will be zipped as well (default: no zip)" << std::endl;
+#endif
+    std::cout << "\t-h                 Print this help" << std::endl;
+    exit(0);
+}
+
+/*
+ * Public functions
+ */
+Options::Options() {
+    outputFile = std::string();
+    traceFile = std::string();
+    memtraceFile = std::string();
+    annotatedFile = std::string();
+    regionsFile = std::string();
+#ifdef ENABLE_GZIP
+    zipped = false;
+#endif
+}
+
+void Options::readOptions(int argc, char *argv[]) {
+    int c;
+    int fileFounds = 0;
+    int optind2 = 1;
+    while ( optind2 < argc ) {
+#ifdef ENABLE_GZIP
+        if (( c = getopt(argc, argv, "a:m:x:o:zh")) != -1 ) {
+#else
+        if (( c = getopt(argc, argv, "a:m:x:o:h")) != -1 ) {
+#endif
+            switch(c) {
+                case 'o':
+                    optind2++;
+                    this->outputFile = std::string(argv[optind2]);
+                    optind2++;
+                    break;
+#ifdef ENABLE_GZIP
+                case 'z':
+                    this->zipped = true;
+                    optind2++;
+                    break;
+#endif
+                case 'a':
+                    optind2++;
+                    this->memtraceFile = std::string(argv[optind2]);
+                    optind2++;
+                    break;
+                case 'm':
+                    optind2++;
+                    this->annotatedFile = std::string(argv[optind2]);
+                    optind2++;
+                    break;
+                case 'x':
+                    optind2++;
+                    this->regionsFile = std::string(argv[optind2]);
+                    optind2++;
+                    break;
+                case 'h':
+                    printHelp();
+                    break;
+                default:
+                    printUsage();
+                    break;
+            }
+        } else {
+            if ( fileFounds == 0 ) {
+                this->traceFile = std::string(argv[optind2]);
+                if ( access(this->traceFile.c_str(), F_OK) == -1 ) {
+                    std::cout << "Instruction trace file not found! Exiting..." << std::endl;
+                    exit(1);
+                }
+
+                fileFounds++;
+            }
+            optind2++;
+        }
+    }
+    if ( fileFounds != 1 ) {
+        printUsage();
+    }
+    if ( !memtraceFile.empty() && access(memtraceFile.c_str(), F_OK) == -1 ) {
+        std::cout << "Memory trace file not found! Exiting..." << std::endl;
+        exit(1);
+    }
+    if ( !memtraceFile.empty() && annotatedFile.empty() ) {
+        annotatedFile = memtraceFile + ".loops";
+    }
+}
+
+std::string Options::getTraceFile() {
+    return traceFile;
+}
+
+std::string Options::getOutFile() {
+    return outputFile;
+}
+
+std::string Options::getMemtraceFile() {
+    return memtraceFile;
+}
+
+std::string Options::getAnnotatedFile() {
+    return annotatedFile;
+}
+
+std::string Options::getRegionsFile() {
+    return regionsFile;
+}
+
+#ifdef ENABLE_GZIP
+bool Options::isZipped() {
+    return zipped;
+}
+#endif
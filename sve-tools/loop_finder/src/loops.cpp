@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Options.hpp"
+#include "LoopTable.hpp"
+
+#include <fstream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef ENABLE_GZIP
+#include <boost/iostreams/filtering_stream.hpp>
+#include <boost/iostreams/filter/gzip.hpp>
+#endif
+
+enum pass { FIND_LOOPS, COUNT_ITERATIONS };
+
+// A loop being executed, and the iterations of the current visit
+struct activeLoop {
+    int id;
+    unsigned long trip;
+};
+
+std::string outputFileName;
+std::ofstream outputFile;
+
+LoopTable loops;
+unsigned long totalInstructions;
+
+// Loops active in every call frame. A call opens a new frame and its return goes back
+// to the caller's, so a loop calling a function is not left while the callee runs
+std::vector< std::vector<activeLoop> > frames;
+
+/*
+ * Instrace lines are <PC>,<Opcode>,<isMem>, with ',' or ';' separators. Every other line
+ * (headers, memtrace lines of a merged meminstrace) is skipped
+ */
+bool parseInstrace ( const std::string &line, unsigned long &pc, unsigned int &encoding, bool &isMem ) {
+    const char *str = line.c_str();
+    char *end;
+    pc = std::strtoul(str, &end, 16);
+    if ( end == str || (*end != ',' && *end != ';') ) {
+        return false;
+    }
+    str = end + 1;
+    encoding = std::strtoul(str, &end, 16);
+    if ( end == str || (*end != ',' && *end != ';') ) {
+        return false;
+    }
+    str = end + 1;
+    isMem = std::strtoul(str, &end, 10) != 0;
+    return end != str && *end == '\0';
+}
+
+void finishVisit ( const activeLoop &visit ) {
+    LoopTable::loop &l = loops[visit.id];
+    if ( l.entries == 1 || visit.trip < l.minTrip ) {
+        l.minTrip = visit.trip;
+    }
+    l.maxTrip = std::max(l.maxTrip, visit.trip);
+}
+
+void leaveFrame () {
+    for ( unsigned int i = 0; i < frames.back().size(); i++ ) {
+        finishVisit(frames.back()[i]);
+    }
+    frames.pop_back();
+}
+
+/*
+ * Loops are entered when the trace gets into their range, and a backward transfer to the
+ * header of an active loop starts a new iteration
+ */
+void countIterations ( unsigned long pc, unsigned long previousPc, bool backward, bool isMem ) {
+    std::vector<activeLoop> &active = frames.back();
+
+    // Leave the loops that do not contain pc anymore, innermost first
+    while ( !active.empty() && !loops.contains(active.back().id, pc) ) {
+        finishVisit(active.back());
+        active.pop_back();
+    }
+
+    int innermost = loops.find(pc);
+    if ( innermost < 0 ) {
+        return;
+    }
+    loops[innermost].instructions++;
+    if ( isMem ) {
+        loops[innermost].memInstructions++;
+    }
+
+    int header = backward ? loops.header(pc) : -1;
+    if ( header >= 0 && loops.contains(header, previousPc) ) {
+        for ( unsigned int i = 0; i < active.size(); i++ ) {
+            if ( active[i].id == header ) {
+                active[i].trip++;
+                loops[header].iterations++;
+                break;
+            }
+        }
+    }
+
+    // Enter the loops containing pc that are not active yet, outermost first
+    std::vector<int> nest;
+    for ( int id = innermost; id >= 0; id = loops[id].parent ) {
+        nest.push_back(id);
+    }
+    for ( int i = nest.size() - 1; i >= 0; i-- ) {
+        bool isActive = false;
+        for ( unsigned int j = 0; j < active.size() && !isActive; j++ ) {
+            isActive = active[j].id == nest[i];
+        }
+        if ( !isActive ) {
+            active.push_back(activeLoop{ nest[i], 1 });
+            loops[nest[i]].entries++;
+            loops[nest[i]].iterations++;
+        }
+    }
+}
+
+void readTrace ( const std::string &traceFileName, bool zipped, int currentPass ) {
+    std::ifstream traceFile(traceFileName, std::ios_base::in | std::ios_base::binary);
+#ifdef ENABLE_GZIP
+    boost::iostreams::filtering_istream zippedTrace;
+    if ( zipped ) {
+        zippedTrace.push(boost::iostreams::gzip_decompressor());
+        zippedTrace.push(traceFile);
+    }
+    std::istream &is = zipped ? static_cast<std::istream &>(zippedTrace) : traceFile;
+#else
+    std::istream &is = traceFile;
+#endif
+
+    std::string line;
+    unsigned long pc;
+    unsigned long previousPc = 0;
+    unsigned int encoding;
+    unsigned int previousEncoding = 0;
+    bool isMem;
+    bool first = true;
+    frames = std::vector< std::vector<activeLoop> >(1);
+    while ( std::getline(is, line) ) {
+        if ( !parseInstrace(line, pc, encoding, isMem) ) {
+            continue;
+        }
+        bool backward = !first && LoopTable::isBackwardTransfer(pc, previousPc, previousEncoding);
+
+        if ( currentPass == FIND_LOOPS ) {
+            totalInstructions++;
+            if ( backward ) {
+                loops.addBackwardTransfer(pc, previousPc);
+            }
+        } else {
+            countIterations(pc, previousPc, backward, isMem);
+            if ( LoopTable::isCall(encoding) ) {
+                frames.push_back(std::vector<activeLoop>());
+            } else if ( LoopTable::isReturn(encoding) ) {
+                leaveFrame();
+                if ( frames.empty() ) { // Returning from the function the trace started in
+                    frames.push_back(std::vector<activeLoop>());
+                }
+            }
+        }
+        previousPc = pc;
+        previousEncoding = encoding;
+        first = false;
+    }
+
+    while ( !frames.empty() ) {
+        leaveFrame();
+    }
+    traceFile.close();
+}
+
+/*
+ * Append the ID of the innermost loop of its PC (-1 if none) to every memtrace line.
+ * The PC is the last field of the line, so the other tools still find every field they use
+ */
+unsigned long annotate ( const std::string &memtraceFileName, const std::string &annotatedFileName, bool zipped ) {
+    std::ifstream memtraceFile(memtraceFileName, std::ios_base::in | std::ios_base::binary);
+    std::ofstream annotatedFile(annotatedFileName, std::ios_base::out | std::ios_base::binary);
+#ifdef ENABLE_GZIP
+    boost::iostreams::filtering_istream zippedMemtrace;
+    boost::iostreams::filtering_ostream zippedAnnotated;
+    if ( zipped ) {
+        zippedMemtrace.push(boost::iostreams::gzip_decompressor());
+        zippedMemtrace.push(memtraceFile);
+        zippedAnnotated.push(boost::iostreams::gzip_compressor());
+        zippedAnnotated.push(annotatedFile);
+    }
+    std::istream &is = zipped ? static_cast<std::istream &>(zippedMemtrace) : memtraceFile;
+    std::ostream &as = zipped ? static_cast<std::ostream &>(zippedAnnotated) : annotatedFile;
+#else
+    std::istream &is = memtraceFile;
+    std::ostream &as = annotatedFile;
+#endif
+
+    std::string line;
+    unsigned long inLoops = 0;
+    while ( std::getline(is, line) ) {
+        size_t separator = line.find_last_of(",:");
+        if ( separator != std::string::npos ) {
+            const char *str = line.c_str() + separator + 1;
+            char *end;
+            unsigned long pc = std::strtoul(str, &end, 0);
+            while ( *end == ' ' || *end == '\r' ) {
+                end++;
+            }
+            if ( end != str && *end == '\0' ) {
+                int id = loops.find(pc);
+                if ( id >= 0 ) {
+                    inLoops++;
+                }
+                as << line << ", " << id << '\n';
+                continue;
+            }
+        }
+        as << line << '\n';
+    }
+
+#ifdef ENABLE_GZIP
+    if ( zipped ) {
+        boost::iostreams::close(zippedAnnotated);
+    }
+#endif
+    annotatedFile.close();
+    memtraceFile.close();
+    return inLoops;
+}
+
+int main (int argc, char *argv[]) {
+    Options opt;
+    opt.readOptions(argc, argv);
+
+#ifdef ENABLE_GZIP
+    bool zipped = opt.isZipped();
+#else
+    bool zipped = false;
+#endif
+
+    std::string traceFileName = opt.getTraceFile();
+    std::string memtraceFileName = opt.getMemtraceFile();
+    std::string regionsFileName = opt.getRegionsFile();
+    outputFileName = opt.getOutFile();
+
+    std::cout << "########################################" << std::endl;
+    std::cout << "#          SUMMARY                     #" << std::endl;
+    std::cout << "########################################" << std::endl;
+    std::cout << "# Instrace file:         " << traceFileName << std::endl;
+    std::cout << "# Memtrace file:         " << (memtraceFileName.empty() ? "none" : memtraceFileName) << std::endl;
+    if ( !memtraceFileName.empty() ) {
+        std::cout << "# Annotated memtrace:    " << opt.getAnnotatedFile() << std::endl;
+    }
+    std::cout << "# Regions file:          " << (regionsFileName.empty() ? "none" : regionsFileName) << std::endl;
+    std::cout << "# Output:                " << (outputFileName.empty() ? "stdout" : outputFileName) << std::endl;
+#ifdef ENABLE_GZIP
+    std::cout << "# Zipped files:          " << (opt.isZipped() ? "YES" : "NO") << std::endl;
+#endif
+    std::cout << "########################################" << std::endl;
+
+    /*
+     * The loops have to be known before their entries can be told apart, so the trace is
+     * read twice: first to find the loops, then to count their iterations
+     */
+    totalInstructions = 0;
+    readTrace(traceFileName, zipped, FIND_LOOPS);
+    loops.build();
+    readTrace(traceFileName, zipped, COUNT_ITERATIONS);
+
+    if ( !outputFileName.empty() ) {
+        outputFile = std::ofstream(outputFileName);
+    }
+
+    /*
+     * Print a report
+     */
+    std::ostream &os = outputFileName.empty() ? std::cout : outputFile;
+    os << std::fixed;
+    os << std::setprecision(4);
+
+    unsigned long inLoops = 0;
+    for ( unsigned int i = 0; i < loops.size(); i++ ) {
+        inLoops += loops[i].instructions;
+    }
+    os << "Instructions            = " << totalInstructions << std::endl;
+    os << "Loops                   = " << loops.size() << std::endl;
+    os << "Instructions in loops   = " << inLoops << std::endl;
+    os << std::endl;
+
+    std::vector<int> order(loops.size());
+    for ( unsigned int i = 0; i < loops.size(); i++ ) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [](int a, int b) {
+        return loops[a].instructions > loops[b].instructions;
+    });
+
+    char buffer[64];
+    os << "loop,start,end,parent,entries,iterations,min. trip count,avg. trip count,max. trip count,"
+       << "instructions,memory instructions,\%total" << std::endl;
+    for ( unsigned int i = 0; i < order.size(); i++ ) {
+        const LoopTable::loop &l = loops[order[i]];
+        snprintf(buffer, sizeof(buffer), "%d,0x%lx,0x%lx,", order[i], l.start, l.end);
+        os << buffer << (l.parent < 0 ? std::string() : std::to_string(l.parent)) << "," << l.entries << ","
+           << l.iterations << "," << l.minTrip << "," << (l.entries ? (double)l.iterations / (double)l.entries : 0.0)
+           << "," << l.maxTrip << "," << l.instructions << "," << l.memInstructions << ","
+           << (totalInstructions ? ((double)l.instructions / (double)totalInstructions) * 100 : 0.0) << std::endl;
+    }
+
+    if ( !regionsFileName.empty() ) {
+        std::ofstream regionsFile(regionsFileName);
+        regionsFile << "# start,end,name" << std::endl;
+        for ( unsigned int i = 0; i < loops.size(); i++ ) {
+            snprintf(buffer, sizeof(buffer), "0x%lx,0x%lx,loop_%u", loops[i].start, loops[i].end, i);
+            regionsFile << buffer << std::endl;
+        }
+        regionsFile.close();
+    }
+
+    if ( !memtraceFileName.empty() ) {
+        unsigned long annotated = annotate(memtraceFileName, opt.getAnnotatedFile(), zipped);
+        std::cout << "Annotated " << annotated << " memory accesses in loops" << std::endl;
+    }
+
+    if ( !outputFileName.empty() ) {
+        outputFile.close();
+    }
+
+    return 0;
+}
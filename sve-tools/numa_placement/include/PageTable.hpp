@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PAGETABLE_HPP
+#define PAGETABLE_HPP
+
+#include <vector>
+
+/*
+ * Page number => first-touching TID
+ *
+ * Open addressing with linear probing over two flat arrays, 12 bytes per slot.
+ * Slots store page + 1 so that 0 marks an empty slot. The table doubles when it
+ * is 3/4 full.
+ */
+class PageTable {
+    std::vector<unsigned long> pages;
+    std::vector<unsigned int> owners;
+    unsigned long mask;
+    unsigned long used;
+
+    unsigned long slot(unsigned long page) const {
+        return ((page * 0x9E3779B97F4A7C15UL) >> 20) & mask;
+    }
+
+    void grow() {
+        std::vector<unsigned long> oldPages;
+        std::vector<unsigned int> oldOwners;
+        oldPages.swap(pages);
+        oldOwners.swap(owners);
+
+        mask = (mask << 1) | 1;
+        pages = std::vector<unsigned long>(mask + 1, 0);
+        owners = std::vector<unsigned int>(mask + 1, 0);
+        for ( unsigned long i = 0; i < oldPages.size(); i++ ) {
+            if ( oldPages[i] != 0 ) {
+                unsigned long s = slot(oldPages[i] - 1);
+                while ( pages[s] != 0 ) {
+                    s = (s + 1) & mask;
+                }
+                pages[s] = oldPages[i];
+                owners[s] = oldOwners[i];
+            }
+        }
+    }
+
+  public:
+    PageTable() : pages(1024, 0), owners(1024, 0), mask(1023), used(0) {}
+
+    // Returns the owner of the page. Untouched pages are assigned to threadId
+    unsigned int touch(unsigned long page, unsigned int threadId, bool &firstTouch) {
+        unsigned long s = slot(page);
+        while ( pages[s] != 0 ) {
+            if ( pages[s] == page + 1 ) {
+                firstTouch = false;
+                return owners[s];
+            }
+            s = (s + 1) & mask;
+        }
+        pages[s] = page + 1;
+        owners[s] = threadId;
+        firstTouch = true;
+        used++;
+        if ( used * 4 > (mask + 1) * 3 ) {
+            grow();
+        }
+        return threadId;
+    }
+
+    unsigned long size() const {
+        return used;
+    }
+};
+
+#endif
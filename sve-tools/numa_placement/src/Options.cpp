@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Options.hpp"
+
+#include <sstream>
+
+/*
+ * Private functions
+ */
+void printUsage() {
+    std::cout << "numa_placement [OPTIONS] merged_memtrace_file" << std::endl;
+    exit(1);
+}
+
+void printHelp() {
+    std::cout << "numa_placement [OPTIONS] merged_memtrace_file" << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "\t-t <threads>     Specify how many threads to use for parallel processing (default: 1)" << std::endl;
+    std::cout << "\t-p <bytes>       Page size, must be a power of two (default: 4096)" << std::endl;
+    std::cout << "\t-n <nodes>       Number of NUMA nodes. TID t runs on node (t % nodes) unless mapped with -m (default: 1)" << std::endl;
+    std::cout << "\t-m <map>         Comma-separated list of TID:node pairs, e.g. 0:0,1:0,2:1,3:1" << std::endl;
+    std::cout << "\t-o <outputFile>  Redirect output to <outputFile> (default: stdout)" << std::endl;
+#ifdef ENABLE_GZIP
+    std::cout << "\t-z               Input files are zipped. Output will be zipped as well (default: no zip)" << std::endl;
+#endif
+    std::cout << "\t-h               Print this help" << std::endl;
+    exit(0);
+}
+
+/*
+ * Public functions
+ */
+Options::Options() {
+    outputFile = std::string();
+    traceFile = std::string();
+    concurrentThreads = 1;
+    pageSize = 4096;
+    numaNodes = 1;
+    threadNodes = std::map<unsigned int, unsigned int>();
+#ifdef ENABLE_GZIP
+    zipped = false;
+#endif
+}
+
+void Options::readOptions(int argc, char *argv[]) {
+    int c;
+    int fileFounds = 0;
+    int optind2 = 1;
+    std::string threadMap;
+    while ( optind2 < argc ) {
+#ifdef ENABLE_GZIP
+        if (( c = getopt(argc, argv, "t:p:n:m:o:zh")) != -1 ) {
+#else
+        if (( c = getopt(argc, argv, "t:p:n:m:o:h")) != -1 ) {
+#endif
+            switch(c) {
+                case 'o':
+                    optind2++;
+                    this->outputFile = std::string(argv[optind2]);
+                    optind2++;
+                    break;
+#ifdef ENABLE_GZIP
+                case 'z':
+                    this->zipped = true;
+                    optind2++;
+                    break;
+#endif
+                case 't':
+                    optind2++;
+                    this->concurrentThreads = std::stoi(argv[optind2]);
+                    optind2++;
+                    break;
+                case 'p':
+                    optind2++;
+                    this->pageSize = std::stoi(argv[optind2]);
+                    optind2++;
+                    break;
+                case 'n':
+                    optind2++;
+                    this->numaNodes = std::stoi(argv[optind2]);
+                    optind2++;
+                    break;
+                case 'm':
+                    optind2++;
+                    threadMap = std::string(argv[optind2]);
+                    optind2++;
+                    break;
+                case 'h':
+                    printHelp();
+                    break;
+                default:
+                    printUsage();
+                    break;
+            }
+        } else {
+            if ( fileFounds == 0 ) {
+                this->traceFile = std::string(argv[optind2]);
+                if ( access(this->traceFile.c_str(), F_OK) == -1 ) {
+                    std::cout << "Memory trace file not found! Exiting..." << std::endl;
+                    exit(1);
+                }
+
+                fileFounds++;
+            }
+            optind2++;
+        }
+    }
+    if ( fileFounds != 1 ) {
+        printUsage();
+    }
+    if ( concurrentThreads < 1 || numaNodes == 0 ) {
+        printUsage();
+    }
+    if ( pageSize == 0 || (pageSize & (pageSize - 1)) != 0 ) {
+        std::cout << "Page size must be a power of two! Exiting..." << std::endl;
+        exit(1);
+    }
+
+    // Parse the TID:node pairs
+    std::stringstream ss(threadMap);
+    while ( !threadMap.empty() && ss.good() ) {
+        std::string pair;
+        std::getline(ss, pair, ',');
+        size_t colon = pair.find(':');
+        if ( colon == std::string::npos ) {
+            std::cout << "Wrong TID:node pair '" << pair << "'! Exiting..." << std::endl;
+            exit(1);
+        }
+        unsigned int node = std::stoi(pair.substr(colon + 1));
+        if ( node >= numaNodes ) {
+            numaNodes = node + 1;
+        }
+        threadNodes[std::stoi(pair.substr(0, colon))] = node;
+    }
+}
+
+std::string Options::getTraceFile() {
+    return traceFile;
+}
+
+std::string Options::getOutFile() {
+    return outputFile;
+}
+
+int Options::getConcurrentThreads() {
+    return concurrentThreads;
+}
+
+unsigned int Options::getPageSize() {
+    return pageSize;
+}
+
+unsigned int Options::getNumaNodes() {
+    return numaNodes;
+}
+
+unsigned int Options::getNode(unsigned int threadId) {
+    std::map<unsigned int, unsigned int>::iterator iter = threadNodes.find(threadId);
+    if ( iter != threadNodes.end() ) {
+        return iter->second;
+    }
+    return threadId % numaNodes;
+}
+
+#ifdef ENABLE_GZIP
+bool Options::isZipped() {
+    return zipped;
+}
+#endif
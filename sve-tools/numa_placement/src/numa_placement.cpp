@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Options.hpp"
+#include "Utils.hpp"
+#include "PageTable.hpp"
+
+#include <fstream>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+
+#include <pthread.h>
+
+#define MIN_CHUNK_SIZE 100000
+
+struct threadInformation {
+    unsigned long accesses;
+    unsigned long firstTouches;
+    unsigned long ownPages;
+    unsigned long sameNodePages;
+    unsigned long remotePages;
+};
+
+Options opt;
+
+std::string outputFileName;
+std::ofstream outputFile;
+
+int concurrentThreads;
+unsigned int pageBits;
+unsigned int numaNodes;
+
+// Chunk being analyzed, while the next one is read
+std::vector<std::string> chunk;
+
+// Pages are sharded among the analysis threads (page % threads), every shard owns its
+// page table and counters. Each shard sees the accesses to its pages in trace order
+std::vector<PageTable> pageTables;
+// Key => TID
+std::vector< std::map<unsigned int, threadInformation> > shardThreadInformation;
+// Accesses from node i to pages first touched on node j: [i * numaNodes + j]
+std::vector< std::vector<unsigned long> > shardNodeAccesses;
+
+// Page accesses of every slice of the chunk, bucketed by shard: [slice][shard]
+struct pageAccess {
+    unsigned long page;
+    unsigned int threadId;
+};
+std::vector< std::vector< std::vector<pageAccess> > > sliceAccesses;
+std::vector<unsigned int> sliceMaxThreadId;
+
+// TID => NUMA node, extended as new TIDs show up
+std::vector<unsigned int> threadNodes;
+
+std::vector<int> workerIds;
+
+// First phase: parse a slice of the chunk and hand every page it touches to its shard
+void *parseSlice ( void *worker ) {
+    int id = *((int*) worker);
+    unsigned long begin = (chunk.size() * id) / concurrentThreads;
+    unsigned long end = (chunk.size() * (id + 1)) / concurrentThreads;
+    std::vector< std::vector<pageAccess> > &shards = sliceAccesses[id];
+    for ( int shard = 0; shard < concurrentThreads; shard++ ) {
+        shards[shard].clear();
+    }
+    unsigned int maxThreadId = 0;
+
+    memRecord record;
+    for ( unsigned long i = begin; i < end; i++ ) {
+        if ( !parseLine(chunk[i], record) || record.dataSize == 0 ) {
+            continue;
+        }
+        maxThreadId = std::max(maxThreadId, record.threadId);
+        unsigned long lastPage = (record.dataAddress + record.dataSize - 1) >> pageBits;
+        for ( unsigned long page = record.dataAddress >> pageBits; page <= lastPage; page++ ) {
+            shards[page % concurrentThreads].push_back(pageAccess{ page, record.threadId });
+        }
+    }
+    sliceMaxThreadId[id] = maxThreadId;
+    pthread_exit(NULL);
+}
+
+// Second phase: every shard walks its own page accesses, slice after slice to keep the trace order
+void *analyzeShard ( void *worker ) {
+    int shard = *((int*) worker);
+    PageTable &pageTable = pageTables[shard];
+    std::map<unsigned int, threadInformation> &threads = shardThreadInformation[shard];
+    std::vector<unsigned long> &nodeAccesses = shardNodeAccesses[shard];
+
+    for ( int slice = 0; slice < concurrentThreads; slice++ ) {
+        const std::vector<pageAccess> &accesses = sliceAccesses[slice][shard];
+        for ( unsigned long i = 0; i < accesses.size(); i++ ) {
+            unsigned int threadId = accesses[i].threadId;
+            bool firstTouch;
+            unsigned int owner = pageTable.touch(accesses[i].page, threadId, firstTouch);
+            unsigned int node = threadNodes[threadId];
+            unsigned int ownerNode = threadNodes[owner];
+
+            threadInformation &info = threads[threadId];
+            info.accesses++;
+            if ( firstTouch ) {
+                info.firstTouches++;
+            }
+            if ( owner == threadId ) {
+                info.ownPages++;
+            } else if ( ownerNode == node ) {
+                info.sameNodePages++;
+            } else {
+                info.remotePages++;
+            }
+            nodeAccesses[node * numaNodes + ownerNode]++;
+        }
+    }
+    pthread_exit(NULL);
+}
+
+void *analyzeChunk ( void *unused ) {
+    pthread_t workers[concurrentThreads];
+
+    for ( int i = 0; i < concurrentThreads; i++ ) {
+        pthread_create(&workers[i], NULL, parseSlice, (void*) &workerIds[i]);
+    }
+    for ( int i = 0; i < concurrentThreads; i++ ) {
+        pthread_join(workers[i], NULL);
+    }
+
+    // Map the new TIDs to their nodes before the shards need them
+    for ( int i = 0; i < concurrentThreads; i++ ) {
+        for ( unsigned int tid = threadNodes.size(); tid <= sliceMaxThreadId[i]; tid++ ) {
+            threadNodes.push_back(opt.getNode(tid));
+        }
+    }
+
+    for ( int i = 0; i < concurrentThreads; i++ ) {
+        pthread_create(&workers[i], NULL, analyzeShard, (void*) &workerIds[i]);
+    }
+    for ( int i = 0; i < concurrentThreads; i++ ) {
+        pthread_join(workers[i], NULL);
+    }
+
+    pthread_exit(NULL);
+}
+
+void printReport ( std::ostream &os ) {
+    // Merge the information of all the shards
+    std::map<unsigned int, threadInformation> threads;
+    std::vector<unsigned long> nodeAccesses(numaNodes * numaNodes, 0);
+    unsigned long pages = 0;
+    for ( int shard = 0; shard < concurrentThreads; shard++ ) {
+        for ( std::map<unsigned int, threadInformation>::iterator iter = shardThreadInformation[shard].begin(); iter != shardThreadInformation[shard].end(); iter++ ) {
+            threadInformation &info = threads[iter->first];
+            info.accesses += iter->second.accesses;
+            info.firstTouches += iter->second.firstTouches;
+            info.ownPages += iter->second.ownPages;
+            info.sameNodePages += iter->second.sameNodePages;
+            info.remotePages += iter->second.remotePages;
+        }
+        for ( unsigned int i = 0; i < numaNodes * numaNodes; i++ ) {
+            nodeAccesses[i] += shardNodeAccesses[shard][i];
+        }
+        pages += pageTables[shard].size();
+    }
+
+    os << std::fixed;
+    os << std::setprecision(4);
+
+    threadInformation total = threadInformation();
+    os << "TID,node,accesses,first-touched pages,own pages,other threads' pages (same node),remote pages,\%remote" << std::endl;
+    for ( std::map<unsigned int, threadInformation>::iterator iter = threads.begin(); iter != threads.end(); iter++ ) {
+        threadInformation &info = iter->second;
+        os << iter->first << "," << opt.getNode(iter->first) << "," << info.accesses << "," << info.firstTouches << ","
+           << info.ownPages << "," << info.sameNodePages << "," << info.remotePages << ","
+           << (info.accesses ? ((double)info.remotePages / (double)info.accesses) * 100 : 0.0) << std::endl;
+        total.accesses += info.accesses;
+        total.firstTouches += info.firstTouches;
+        total.ownPages += info.ownPages;
+        total.sameNodePages += info.sameNodePages;
+        total.remotePages += info.remotePages;
+    }
+    os << "total,-," << total.accesses << "," << total.firstTouches << "," << total.ownPages << ","
+       << total.sameNodePages << "," << total.remotePages << ","
+       << (total.accesses ? ((double)total.remotePages / (double)total.accesses) * 100 : 0.0) << std::endl;
+
+    os << std::endl;
+    os << "node";
+    for ( unsigned int j = 0; j < numaNodes; j++ ) {
+        os << ",accesses to node " << j;
+    }
+    os << std::endl;
+    for ( unsigned int i = 0; i < numaNodes; i++ ) {
+        os << i;
+        for ( unsigned int j = 0; j < numaNodes; j++ ) {
+            os << "," << nodeAccesses[i * numaNodes + j];
+        }
+        os << std::endl;
+    }
+
+    os << std::endl;
+    os << "Total Pages             = " << pages << std::endl;
+}
+
+int main (int argc, char *argv[]) {
+    opt.readOptions(argc, argv);
+
+    concurrentThreads = opt.getConcurrentThreads();
+    numaNodes = opt.getNumaNodes();
+    pageBits = 0;
+    while ( (1U << pageBits) < opt.getPageSize() ) {
+        pageBits++;
+    }
+
+    pageTables = std::vector<PageTable>(concurrentThreads);
+    shardThreadInformation = std::vector< std::map<unsigned int, threadInformation> >(concurrentThreads);
+    shardNodeAccesses = std::vector< std::vector<unsigned long> >(concurrentThreads, std::vector<unsigned long>(numaNodes * numaNodes, 0));
+    sliceAccesses = std::vector< std::vector< std::vector<pageAccess> > >(concurrentThreads,
+                        std::vector< std::vector<pageAccess> >(concurrentThreads));
+    sliceMaxThreadId = std::vector<unsigned int>(concurrentThreads, 0);
+    workerIds = std::vector<int>(concurrentThreads);
+    for ( int i = 0; i < concurrentThreads; i++ ) {
+        workerIds[i] = i;
+    }
+
+    pthread_t analyzeThread;
+    bool runningChunk = false;
+
+    std::string traceFileName = opt.getTraceFile();
+    outputFileName = opt.getOutFile();
+
+    std::cout << "########################################" << std::endl;
+    std::cout << "#          SUMMARY                     #" << std::endl;
+    std::cout << "########################################" << std::endl;
+    std::cout << "# Page size:             " << opt.getPageSize() << " bytes" << std::endl;
+    std::cout << "# NUMA nodes:            " << numaNodes << std::endl;
+    std::cout << "# Memtrace file:         " << traceFileName << std::endl;
+    std::cout << "# Output:                " << (outputFileName.empty() ? "stdout" : outputFileName) << std::endl;
+#ifdef ENABLE_GZIP
+    std::cout << "# Zipped files:          " << (opt.isZipped() ? "YES" : "NO") << std::endl;
+#endif
+    std::cout << "########################################" << std::endl;
+
+    /*
+     * First of all, open files
+     */
+    std::ifstream traceFile(traceFileName);
+    if ( !outputFileName.empty() ) {
+        outputFile = std::ofstream(outputFileName);
+    }
+
+    std::string line;
+    std::vector<std::string> chunkContents;
+    chunkContents.clear();
+
+    int typeOfLine;
+    typeOfLine = readLine(traceFile, line);
+    while ( typeOfLine != END_OF_FILE ) {
+        chunkContents.push_back(line);
+        typeOfLine = readLine(traceFile, line);
+
+        /*
+         * If we've completed a chunk, wait for the previous one to be analyzed and hand it over
+         */
+        if ( chunkContents.size() >= MIN_CHUNK_SIZE ) {
+            if ( runningChunk ) {
+                pthread_join(analyzeThread, NULL);
+            }
+            chunk.swap(chunkContents);
+            chunkContents.clear();
+            pthread_create(&analyzeThread, NULL, analyzeChunk, NULL);
+            runningChunk = true;
+        }
+    }
+
+    // Analyze whatever was left when we reached EOF
+    if ( runningChunk ) {
+        pthread_join(analyzeThread, NULL);
+    }
+    chunk.swap(chunkContents);
+    pthread_create(&analyzeThread, NULL, analyzeChunk, NULL);
+    pthread_join(analyzeThread, NULL);
+
+    /*
+     * Print a report
+     */
+    if ( outputFileName.empty() ) {
+        printReport(std::cout);
+    } else {
+        printReport(outputFile);
+    }
+
+    traceFile.close();
+    if ( !outputFileName.empty() ) {
+        outputFile.close();
+    }
+
+    return 0;
+}
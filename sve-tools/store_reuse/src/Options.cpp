@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Options.hpp"
+
+/*
+ * Private functions
+ */
+void printUsage() {
+    std::cout << "store_reuse [OPTIONS] merged_memtrace_file" << std::endl;
+    exit(1);
+}
+
+void printHelp() {
+    std::cout << "store_reuse [OPTIONS] merged_memtrace_file" << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "\t-w <records>     Report loads that read data stored within the last <records> memory accesses (default: 64)" << std::endl;
+    std::cout << "\t-e <entries>     Number of entries of the recent-store table, must be a power of two (default: 65536)" << std::endl;
+    std::cout << "\t-n <PCs>         Number of load PCs to report (default: 10)" << std::endl;
+    std::cout << "\t-o <outputFile>  Redirect output to <outputFile> (default: stdout)" << std::endl;
+#ifdef ENABLE_GZIP
+    std::cout << "\t-z               Input files are zipped. Output will be zipped as well (default: no zip)" << std::endl;
+#endif
+    std::cout << "\t-h               Print this help" << std::endl;
+    exit(0);
+}
+
+/*
+ * Public functions
+ */
+Options::Options() {
+    outputFile = std::string();
+    traceFile = std::string();
+    window = 64;
+    tableEntries = 65536;
+    topPCs = 10;
+#ifdef ENABLE_GZIP
+    zipped = false;
+#endif
+}
+
+void Options::readOptions(int argc, char *argv[]) {
+    int c;
+    int fileFounds = 0;
+    int optind2 = 1;
+    while ( optind2 < argc ) {
+#ifdef ENABLE_GZIP
+        if (( c = getopt(argc, argv, "w:e:n:o:zh")) != -1 ) {
+#else
+        if (( c = getopt(argc, argv, "w:e:n:o:h")) != -1 ) {
+#endif
+            switch(c) {
+                case 'o':
+                    optind2++;
+                    this->outputFile = std::string(argv[optind2]);
+                    optind2++;
+                    break;
+#ifdef ENABLE_GZIP
+                case 'z':
+                    this->zipped = true;
+                    optind2++;
+                    break;
+#endif
+                case 'w':
+                    optind2++;
+                    this->window = std::stoul(argv[optind2]);
+                    optind2++;
+                    break;
+                case 'e':
+                    optind2++;
+                    this->tableEntries = std::stoul(argv[optind2]);
+                    optind2++;
+                    break;
+                case 'n':
+                    optind2++;
+                    this->topPCs = std::stoi(argv[optind2]);
+                    optind2++;
+                    break;
+                case 'h':
+                    printHelp();
+                    break;
+                default:
+                    printUsage();
+                    break;
+            }
+        } else {
+            if ( fileFounds == 0 ) {
+                this->traceFile = std::string(argv[optind2]);
+                if ( access(this->traceFile.c_str(), F_OK) == -1 ) {
+                    std::cout << "Memory trace file not found! Exiting..." << std::endl;
+                    exit(1);
+                }
+
+                fileFounds++;
+            }
+            optind2++;
+        }
+    }
+    if ( fileFounds != 1 ) {
+        printUsage();
+    }
+    if ( window == 0 ) {
+        std::cout << "Window must be at least one record! Exiting..." << std::endl;
+        exit(1);
+    }
+    if ( tableEntries == 0 || (tableEntries & (tableEntries - 1)) != 0 ) {
+        std::cout << "Table entries must be a power of two! Exiting..." << std::endl;
+        exit(1);
+    }
+}
+
+std::string Options::getTraceFile() {
+    return traceFile;
+}
+
+std::string Options::getOutFile() {
+    return outputFile;
+}
+
+unsigned long Options::getWindow() {
+    return window;
+}
+
+unsigned long Options::getTableEntries() {
+    return tableEntries;
+}
+
+unsigned int Options::getTopPCs() {
+    return topPCs;
+}
+
+#ifdef ENABLE_GZIP
+bool Options::isZipped() {
+    return zipped;
+}
+#endif
@@ -0,0 +1,373 @@
+/*
+ * Copyright (c) 2019, Arm Limited and Contributors.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "Options.hpp"
+#include "Utils.hpp"
+
+#include <fstream>
+#include <vector>
+#include <map>
+#include <unordered_map>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+
+#include <pthread.h>
+
+#define MIN_CHUNK_SIZE 10000
+
+// Stores are tracked with an 8-byte granularity, each entry keeps a mask of the bytes written
+#define GRANULE_BITS 3
+
+enum loadClass { NON_SVE_LOAD = 0, SVE_CONTIG_LOAD = 1, SVE_GATHER_LOAD = 2, NUM_LOAD_CLASSES = 3 };
+
+// One entry of the recent-store table. Record 0 means the entry was never written
+struct storeEntry {
+    unsigned long granule;
+    unsigned long record;
+    unsigned long pc;
+    unsigned char mask;
+    bool isSve;
+};
+
+struct pcInformation {
+    unsigned long loads;
+    unsigned long forwarded;
+    unsigned long totalDistance;
+};
+
+std::string outputFileName;
+std::ofstream outputFile;
+
+// The analysis is sequential: while one chunk is analyzed the next one is being read
+std::vector<std::string> chunk;
+
+unsigned long window;
+unsigned long tableMask;
+std::vector<storeEntry> storeTable;
+
+// Index of the memory instruction being analyzed. A whole gather/scatter counts as one record
+unsigned long currentRecord;
+
+unsigned long loads[NUM_LOAD_CLASSES];
+unsigned long forwardedLoads[NUM_LOAD_CLASSES];
+unsigned long stores;
+
+// Bucket b counts the loads with a distance in [2^b, 2^(b+1) - 1]
+std::vector<unsigned long> distanceHistogram;
+
+// Key => load PC
+std::unordered_map<unsigned long, pcInformation> pcInformationMap;
+
+// Key   => (SVE store PC, gather PC)
+// Value => gather elements reading the store
+std::map<std::pair<unsigned long, unsigned long>, unsigned long> storeGatherPairs;
+
+unsigned long tableIndex ( unsigned long granule ) {
+    return ((granule * 0x9E3779B97F4A7C15UL) >> 24) & tableMask;
+}
+
+unsigned char granuleMask ( unsigned long granule, unsigned long firstByte, unsigned long lastByte ) {
+    unsigned int lo = (granule == (firstByte >> GRANULE_BITS)) ? (firstByte & 0x7) : 0;
+    unsigned int hi = (granule == (lastByte >> GRANULE_BITS)) ? (lastByte & 0x7) : 7;
+    return (unsigned char)((0xFF >> (7 - hi)) & (0xFF << lo));
+}
+
+void recordStore ( memRecord &record, bool isSve ) {
+    if ( record.dataSize == 0 ) {
+        return;
+    }
+    unsigned long firstByte = record.dataAddress;
+    unsigned long lastByte = record.dataAddress + record.dataSize - 1;
+    for ( unsigned long g = firstByte >> GRANULE_BITS; g <= (lastByte >> GRANULE_BITS); g++ ) {
+        // The youngest store always replaces whatever was in the entry
+        storeEntry &entry = storeTable[tableIndex(g)];
+        entry.granule = g;
+        entry.record = currentRecord;
+        entry.pc = record.pc;
+        entry.mask = granuleMask(g, firstByte, lastByte);
+        entry.isSve = isSve;
+    }
+}
+
+// Returns the youngest store in the window that wrote any of the bytes read, or NULL
+storeEntry *findStore ( memRecord &record ) {
+    storeEntry *youngest = NULL;
+    if ( record.dataSize == 0 ) {
+        return youngest;
+    }
+    unsigned long firstByte = record.dataAddress;
+    unsigned long lastByte = record.dataAddress + record.dataSize - 1;
+    for ( unsigned long g = firstByte >> GRANULE_BITS; g <= (lastByte >> GRANULE_BITS); g++ ) {
+        storeEntry &entry = storeTable[tableIndex(g)];
+        if ( entry.record != 0 && entry.granule == g && (entry.mask & granuleMask(g, firstByte, lastByte)) != 0
+                && currentRecord - entry.record <= window ) {
+            if ( youngest == NULL || entry.record > youngest->record ) {
+                youngest = &entry;
+            }
+        }
+    }
+    return youngest;
+}
+
+void recordLoad ( int type, unsigned long pc, storeEntry *store ) {
+    pcInformation &info = pcInformationMap[pc];
+    info.loads++;
+    loads[type]++;
+    if ( store != NULL ) {
+        unsigned long distance = currentRecord - store->record;
+        unsigned int bucket = 0;
+        while ( (distance >> (bucket + 1)) != 0 ) {
+            bucket++;
+        }
+        distanceHistogram[bucket]++;
+        info.forwarded++;
+        info.totalDistance += distance;
+        forwardedLoads[type]++;
+    }
+}
+
+// Threaded analyzer. Records are analyzed in trace order, so only one of these runs at a time
+void *analyzeChunk ( void *unused ) {
+    memRecord record;
+    for ( int i = 0; i < chunk.size(); i++ ) {
+        if ( !parseLine(chunk[i], record) ) {
+            continue;
+        }
+        currentRecord++;
+
+        if ( getTypeOfLine(chunk[i]) == AARCH64_LINE ) {
+            if ( record.isWrite == 1 ) {
+                recordStore(record, false);
+                stores++;
+            } else {
+                recordLoad(NON_SVE_LOAD, record.pc, findStore(record));
+            }
+        } else if ( (record.isBundle & 0x1) != 0 ) { // scatter/gather start
+            if ( record.isWrite == 1 ) {
+                recordStore(record, true);
+                while ( (record.isBundle & 0x4) == 0 && i + 1 < chunk.size() ) {
+                    i++;
+                    parseLine(chunk[i], record);
+                    recordStore(record, true);
+                }
+                stores++;
+            } else {
+                // All the elements are looked up before the bundle stores anything, the youngest
+                // match of the whole gather is used for the distance
+                unsigned long gatherPC = record.pc;
+                storeEntry *youngest = NULL;
+                while ( true ) {
+                    storeEntry *store = findStore(record);
+                    if ( store != NULL ) {
+                        if ( store->isSve ) {
+                            storeGatherPairs[std::make_pair(store->pc, gatherPC)]++;
+                        }
+                        if ( youngest == NULL || store->record > youngest->record ) {
+                            youngest = store;
+                        }
+                    }
+                    if ( (record.isBundle & 0x4) != 0 || i + 1 >= chunk.size() ) {
+                        break;
+                    }
+                    i++;
+                    parseLine(chunk[i], record);
+                }
+                recordLoad(SVE_GATHER_LOAD, gatherPC, youngest);
+            }
+        } else { // contiguous SVE load/store
+            if ( record.isWrite == 1 ) {
+                recordStore(record, true);
+                stores++;
+            } else {
+                recordLoad(SVE_CONTIG_LOAD, record.pc, findStore(record));
+            }
+        }
+    }
+
+    pthread_exit(NULL);
+}
+
+void printReport ( std::ostream &os, unsigned int topPCs ) {
+    const char *classNames[NUM_LOAD_CLASSES] = { "non-SVE", "SVE-contiguous", "SVE-gather" };
+    unsigned long totalLoads = 0;
+    unsigned long totalForwarded = 0;
+
+    os << std::fixed;
+    os << std::setprecision(4);
+
+    os << "load type,Loads,Loads-from-recent-stores,\%loads" << std::endl;
+    for ( int type = 0; type < NUM_LOAD_CLASSES; type++ ) {
+        os << classNames[type] << "," << loads[type] << "," << forwardedLoads[type] << ","
+           << (loads[type] ? ((double)forwardedLoads[type] / (double)loads[type]) * 100 : 0.0) << std::endl;
+        totalLoads += loads[type];
+        totalForwarded += forwardedLoads[type];
+    }
+    os << "total," << totalLoads << "," << totalForwarded << ","
+       << (totalLoads ? ((double)totalForwarded / (double)totalLoads) * 100 : 0.0) << std::endl;
+
+    os << std::endl;
+    os << "distance (records),#loads,\%loads-from-recent-stores" << std::endl;
+    for ( unsigned int bucket = 0; bucket < distanceHistogram.size(); bucket++ ) {
+        unsigned long first = 1UL << bucket;
+        unsigned long last = std::min((first << 1) - 1, window);
+        if ( first == last ) {
+            os << first;
+        } else {
+            os << first << "-" << last;
+        }
+        os << "," << distanceHistogram[bucket] << ","
+           << (totalForwarded ? ((double)distanceHistogram[bucket] / (double)totalForwarded) * 100 : 0.0) << std::endl;
+    }
+
+    // Rank the load PCs by the number of loads reading recent stores
+    std::vector< std::pair<unsigned long, pcInformation> > pcs(pcInformationMap.begin(), pcInformationMap.end());
+    std::sort(pcs.begin(), pcs.end(),
+              [](const std::pair<unsigned long, pcInformation> &a, const std::pair<unsigned long, pcInformation> &b) {
+                  return a.second.forwarded > b.second.forwarded
+                      || (a.second.forwarded == b.second.forwarded && a.first < b.first);
+              });
+
+    os << std::endl;
+    os << "load PC,#loads,#loads-from-recent-stores,\%loads-from-recent-stores,avg. distance (records)" << std::endl;
+    for ( unsigned int i = 0; i < pcs.size() && i < topPCs; i++ ) {
+        pcInformation &info = pcs[i].second;
+        if ( info.forwarded == 0 ) {
+            break;
+        }
+        os << "0x" << std::hex << pcs[i].first << std::dec << "," << info.loads << "," << info.forwarded << ","
+           << ((double)info.forwarded / (double)info.loads) * 100 << ","
+           << (double)info.totalDistance / (double)info.forwarded << std::endl;
+    }
+
+    os << std::endl;
+    os << "SVE store PC,gather PC,#gather elements reading the store" << std::endl;
+    for ( std::map<std::pair<unsigned long, unsigned long>, unsigned long>::iterator iter = storeGatherPairs.begin(); iter != storeGatherPairs.end(); iter++ ) {
+        os << "0x" << std::hex << iter->first.first << ",0x" << iter->first.second << std::dec << "," << iter->second << std::endl;
+    }
+}
+
+int main (int argc, char *argv[]) {
+    Options opt;
+    opt.readOptions(argc, argv);
+
+    window = opt.getWindow();
+    tableMask = opt.getTableEntries() - 1;
+    storeTable = std::vector<storeEntry>(opt.getTableEntries(), storeEntry());
+
+    unsigned int buckets = 1;
+    while ( (window >> buckets) != 0 ) {
+        buckets++;
+    }
+    distanceHistogram = std::vector<unsigned long>(buckets, 0);
+
+    currentRecord = 0;
+    stores = 0;
+    for ( int type = 0; type < NUM_LOAD_CLASSES; type++ ) {
+        loads[type] = 0;
+        forwardedLoads[type] = 0;
+    }
+
+    pthread_t analyzeThread;
+    bool runningChunk = false;
+
+    std::string traceFileName = opt.getTraceFile();
+    outputFileName = opt.getOutFile();
+
+    std::cout << "########################################" << std::endl;
+    std::cout << "#          SUMMARY                     #" << std::endl;
+    std::cout << "########################################" << std::endl;
+    std::cout << "# Window:                " << window << " records" << std::endl;
+    std::cout << "# Store table entries:   " << opt.getTableEntries() << std::endl;
+    std::cout << "# Memtrace file:         " << traceFileName << std::endl;
+    std::cout << "# Output:                " << (outputFileName.empty() ? "stdout" : outputFileName) << std::endl;
+#ifdef ENABLE_GZIP
+    std::cout << "# Zipped files:          " << (opt.isZipped() ? "YES" : "NO") << std::endl;
+#endif
+    std::cout << "########################################" << std::endl;
+
+    /*
+     * First of all, open files
+     */
+    std::ifstream traceFile(traceFileName);
+    if ( !outputFileName.empty() ) {
+        outputFile = std::ofstream(outputFileName);
+    }
+
+    std::string line;
+    std::vector<std::string> chunkContents;
+    chunkContents.clear();
+
+    int typeOfLine;
+    typeOfLine = readLine(traceFile, line);
+    while ( typeOfLine != END_OF_FILE ) {
+        /*
+         * Check the line and add it to the chunk, keeping gathers/scatters in a single chunk
+         */
+        if ( typeOfLine == SVE_LINE && isGatherScatterStart(line) ) {
+            chunkContents.push_back(line);
+            while ( ! isGatherScatterEnd(line) ) {
+                typeOfLine = readLine(traceFile, line);
+                if ( typeOfLine == END_OF_FILE ) {
+                    break;
+                }
+                chunkContents.push_back(line);
+            }
+        } else {
+            chunkContents.push_back(line);
+        }
+        typeOfLine = readLine(traceFile, line);
+
+        /*
+         * If we've completed a chunk, wait for the previous one to be analyzed and hand it over
+         */
+        if ( chunkContents.size() >= MIN_CHUNK_SIZE ) {
+            if ( runningChunk ) {
+                pthread_join(analyzeThread, NULL);
+            }
+            chunk.swap(chunkContents);
+            chunkContents.clear();
+            pthread_create(&analyzeThread, NULL, analyzeChunk, NULL);
+            runningChunk = true;
+        }
+    }
+
+    // Analyze whatever was left when we reached EOF
+    if ( runningChunk ) {
+        pthread_join(analyzeThread, NULL);
+    }
+    chunk.swap(chunkContents);
+    pthread_create(&analyzeThread, NULL, analyzeChunk, NULL);
+    pthread_join(analyzeThread, NULL);
+
+    /*
+     * Print a report
+     */
+    if ( outputFileName.empty() ) {
+        printReport(std::cout, opt.getTopPCs());
+    } else {
+        printReport(outputFile, opt.getTopPCs());
+    }
+
+    traceFile.close();
+    if ( !outputFileName.empty() ) {
+        outputFile.close();
+    }
+
+    return 0;
+}